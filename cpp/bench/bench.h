@@ -0,0 +1,131 @@
+#pragma once
+
+#include "individual.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace bench
+ * @brief A minimal timing harness shared by the benchmarks.
+ *
+ * @details A measure runs its body in a loop long enough to last `min_time`,
+ * takes the best of `repeats` such samples and reports the time of one
+ * operation. The results are collected in a `report`, which prints them as a
+ * table and saves them as JSON, so that runs of two releases can be
+ * compared by `python/compare_benchmarks.py`.
+ */
+namespace bench {
+    using clock = std::chrono::steady_clock;
+    using json = nlohmann::json;
+
+    /* Keeps the compiler from optimizing `value` away. */
+    template <typename T>
+    inline void keep(const T &value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /* How long each measure runs. */
+    struct settings {
+        double min_time = 0.05; // seconds per sample
+        size_t repeats = 3;     // samples per measure, the best is kept
+    };
+
+    /**
+     * @brief The best time of one operation, in nanoseconds.
+     *
+     * @param body Performs `ops` operations per call.
+     */
+    template <typename F>
+    double time_per_op(const settings &s, size_t ops, F &&body) {
+        // Calibrate the number of calls per sample on a first call
+        auto start = clock::now();
+        body();
+        double once = std::chrono::duration<double>(clock::now() - start).count();
+        size_t calls = once > 0 ? std::max<size_t>(1, size_t(s.min_time / once)) : 1000;
+
+        double best = std::numeric_limits<double>::infinity();
+        for (size_t r = 0; r < s.repeats; r++) {
+            start = clock::now();
+            for (size_t c = 0; c < calls; c++)
+                body();
+            std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+            best = std::min(best, elapsed.count() / (calls * ops));
+        }
+        return best;
+    }
+
+    /* Random objective values in [0, levels), mimicking the small integer values of mLOTZ. */
+    template <typename T>
+    objective::basic_matrix<T> random_objectives(size_t n, size_t m, int levels,
+                                                 std::mt19937 &gen) {
+        std::uniform_int_distribution<int> dist(0, levels - 1);
+        objective::basic_matrix<T> objectives(n, m);
+        for (size_t i = 0; i < n; i++)
+            for (size_t k = 0; k < m; k++)
+                objectives.row(i)[k] = static_cast<T>(dist(gen));
+        return objectives;
+    }
+
+    /* The results of a run of the benchmarks. */
+    class report {
+        json metadata = json::object();
+        std::vector<json> results;
+        std::string filter;
+
+      public:
+        explicit report(std::string filter = "") : filter(std::move(filter)) {}
+
+        /* Whether the benchmark `group/name` is selected by the filter. */
+        bool selected(const std::string &group, const std::string &name) const {
+            return filter.empty() || (group + "/" + name).find(filter) != std::string::npos;
+        }
+
+        /* Describes the run, e.g. the compiler or the build type. */
+        void describe(const std::string &key, json value) { metadata[key] = std::move(value); }
+
+        /**
+         * @brief Adds a result and prints it.
+         *
+         * @param params The parameters of the measure, e.g. `{{"n", 64}}`.
+         * @param ns_per_op The time of one operation, whose unit is `unit`.
+         * @param extra Other values of the measure.
+         */
+        void add(const std::string &group, const std::string &name, json params,
+                 const std::string &unit, double ns_per_op, json extra = json::object()) {
+            json result = {{"group", group},   {"name", name},
+                           {"params", params}, {"unit", unit},
+                           {"ns_per_op", ns_per_op}, {"ops_per_second", 1e9 / ns_per_op}};
+            if (!extra.empty())
+                result["extra"] = std::move(extra);
+            std::println("{0:<12} {1:<24} {2:<36} {3:>14.1f} ns/{4}", group, name, params.dump(),
+                         ns_per_op, unit);
+            results.push_back(std::move(result));
+        }
+
+        /* The metadata and the results. */
+        json to_json() const {
+            json out;
+            out["metadata"] = metadata;
+            out["results"] = results;
+            return out;
+        }
+
+        /* Writes `to_json()` to `filename`. */
+        void save(const std::string &filename) const {
+            std::ofstream file(filename, std::ios::trunc);
+            if (!file.is_open())
+                throw std::runtime_error("Unable to open " + filename);
+            file << to_json().dump(2) << std::endl;
+        }
+    };
+} // namespace bench
@@ -0,0 +1,92 @@
+#include "binaryheap.h"
+#include "cxxopts.hpp"
+#include <chrono>
+#include <print>
+#include <random>
+#include <vector>
+
+using binary_heap::Node;
+
+/* Times of emplace, decrease_key and extract_min in nanoseconds per operation. */
+struct timings {
+    double emplace = 0.0;
+    double decrease_key = 0.0;
+    double extract_min = 0.0;
+};
+
+template <typename Heap>
+timings time_heap(Heap heap, const std::vector<double> &keys,
+                  const std::vector<size_t> &decreased) {
+    using clock = std::chrono::steady_clock;
+    size_t n = keys.size();
+    timings t;
+
+    auto start = clock::now();
+    for (size_t i = 0; i < n; i++)
+        heap.emplace(Node<double, size_t>{.key = keys[i], .id = i});
+    auto end = clock::now();
+    t.emplace = std::chrono::duration<double, std::nano>(end - start).count() / n;
+
+    start = clock::now();
+    for (size_t i : decreased)
+        heap.decrease_key(i, -keys[i]);
+    end = clock::now();
+    t.decrease_key =
+        std::chrono::duration<double, std::nano>(end - start).count() / decreased.size();
+
+    double checksum = 0.0;
+    start = clock::now();
+    while (heap.size() > 0)
+        checksum += heap.extract_min().key;
+    end = clock::now();
+    t.extract_min = std::chrono::duration<double, std::nano>(end - start).count() / n;
+
+    if (checksum == 42.0)
+        std::println("");
+    return t;
+}
+
+int main(int argc, char **argv) {
+    using namespace cxxopts;
+    // clang-format off
+    cxxopts::Options options(argv[0], "Indexed heap benchmark");
+    options.add_options()
+      ("max_n", "Largest number of elements", value<size_t>()->default_value("1000000"))
+      ("seed", "Seed for the random number generator", value<uint32_t>()->default_value("0"))
+      ("h,help", "Print usage");
+    // clang-format on
+
+    auto result = options.parse(argc, argv);
+    if (result.count("help")) {
+        std::println("{0}", options.help());
+        return 0;
+    }
+    size_t max_n = result["max_n"].as<size_t>();
+    std::mt19937 gen(result["seed"].as<uint32_t>());
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    std::println("{0:>8} {1:>16} {2:>12} {3:>12} {4:>12}", "N", "heap", "emplace",
+                 "decrease_key", "extract_min");
+    for (size_t n : {1000, 10000, 100000, 1000000}) {
+        if (n > max_n)
+            continue;
+        std::vector<double> keys(n);
+        for (double &key : keys)
+            key = dist(gen);
+        std::vector<size_t> decreased(n / 2);
+        std::uniform_int_distribution<size_t> index(0, n - 1);
+        for (size_t &i : decreased)
+            i = index(gen);
+
+        auto report = [&](const char *name, timings t) {
+            std::println("{0:>8} {1:>16} {2:>12.1f} {3:>12.1f} {4:>12.1f}", n, name, t.emplace,
+                         t.decrease_key, t.extract_min);
+        };
+        using binary_heap::BinaryHeap;
+        using binary_heap::DenseHeap;
+        report("BinaryHeap", time_heap(BinaryHeap<double, size_t>(), keys, decreased));
+        report("DenseHeap<2>", time_heap(DenseHeap<double, size_t, 2>(n), keys, decreased));
+        report("DenseHeap<4>", time_heap(DenseHeap<double, size_t, 4>(n), keys, decreased));
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "bench.h"
+#include "cxxopts.hpp"
+#include "individual.h"
+#include "sorting.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <format>
+#include <print>
+#include <random>
+
+using objective::matrix_t;
+using sorting::fronts_t;
+
+fronts_t normalized(fronts_t fronts) {
+    for (auto &front : fronts)
+        std::sort(front.begin(), front.end());
+    return fronts;
+}
+
+/* Best wall time of `repeats` runs in milliseconds, and the fronts of the last run. */
+double time_sort(const matrix_t &objectives, sorting::strategy s, parallel::ThreadPool &pool,
+                 size_t repeats, fronts_t &fronts) {
+    double best = std::numeric_limits<double>::infinity();
+    for (size_t r = 0; r < repeats; r++) {
+        auto start = std::chrono::steady_clock::now();
+        fronts = sorting::sort(objectives, s, &pool);
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char **argv) {
+    using namespace cxxopts;
+    // clang-format off
+    cxxopts::Options options(argv[0], "Non-dominated sorting benchmark");
+    options.add_options()
+      ("max_n", "Largest population size", value<size_t>()->default_value("10000"))
+      ("graph_max_n", "Largest population size for the graph engine",
+       value<size_t>()->default_value("4000"))
+      ("quadratic_max_n", "Largest population size for the other O(N^2) engines",
+       value<size_t>()->default_value("10000"))
+      ("levels", "Number of distinct values per objective", value<int>()->default_value("32"))
+      ("repeats", "Number of runs per measure", value<size_t>()->default_value("3"))
+      ("seed", "Seed for the random number generator", value<uint32_t>()->default_value("0"))
+      ("threads", "Number of threads of the engines that support them",
+       value<size_t>()->default_value("1"))
+      ("h,help", "Print usage");
+    // clang-format on
+
+    auto result = options.parse(argc, argv);
+    if (result.count("help")) {
+        std::println("{0}", options.help());
+        return 0;
+    }
+
+    size_t max_n = result["max_n"].as<size_t>();
+    size_t graph_max_n = result["graph_max_n"].as<size_t>();
+    size_t quadratic_max_n = result["quadratic_max_n"].as<size_t>();
+    int levels = result["levels"].as<int>();
+    size_t repeats = result["repeats"].as<size_t>();
+    std::mt19937 gen(result["seed"].as<uint32_t>());
+    parallel::ThreadPool pool(result["threads"].as<size_t>());
+
+    using sorting::strategy;
+    const std::vector<strategy> strategies{strategy::graph,        strategy::deb,
+                                           strategy::ens_ss,       strategy::ens_bs,
+                                           strategy::bi_objective, strategy::divide_conquer};
+
+    // One line per (m, N) with the time of each engine in milliseconds and the
+    // fastest engine, which shows where the engines cross over
+    std::print("{0:>3} {1:>8} {2:>7}", "m", "N", "fronts");
+    for (sorting::strategy s : strategies)
+        std::print(" {0:>10}", sorting::to_string(s));
+    std::println(" {0:>10}", "fastest");
+
+    for (size_t m : {2, 3, 4, 6, 8, 10}) {
+        for (size_t n : {100, 500, 1000, 2000, 5000, 10000, 100000, 1000000}) {
+            if (n > max_n)
+                continue;
+            matrix_t objectives = bench::random_objectives<double>(n, m, levels, gen);
+            fronts_t reference;
+            double best = std::numeric_limits<double>::infinity();
+            sorting::strategy fastest = strategies[0];
+            std::string line;
+            for (sorting::strategy s : strategies) {
+                bool skip = (s == sorting::strategy::graph && n > graph_max_n) ||
+                            (s == sorting::strategy::bi_objective && m != 2) ||
+                            (s != sorting::strategy::bi_objective &&
+                             s != sorting::strategy::divide_conquer && n > quadratic_max_n);
+                if (skip) {
+                    line += std::format(" {0:>10}", "-");
+                    continue;
+                }
+                fronts_t fronts;
+                double ms = time_sort(objectives, s, pool, repeats, fronts);
+                fronts = normalized(std::move(fronts));
+                if (reference.empty())
+                    reference = fronts;
+                else if (fronts != reference)
+                    throw std::runtime_error("sorting engines disagree on the fronts");
+                if (ms < best) {
+                    best = ms;
+                    fastest = s;
+                }
+                line += std::format(" {0:>10.3f}", ms);
+            }
+            std::println("{0:>3} {1:>8} {2:>7}{3} {4:>10}", m, n, reference.size(), line,
+                         sorting::to_string(fastest));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,266 @@
+#include "bench.h"
+#include "benchmark.h"
+#include "cxxopts.hpp"
+#include "dominance.h"
+#include "evaluation.h"
+#include "individual.h"
+#include "modified_nsga2.h"
+#include "mutation.h"
+#include "nsga2.h"
+#include "population.h"
+#include "profiling.h"
+#include "rng.h"
+#include "sorting.h"
+#include "utils.h"
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+using bench::json;
+using bench::random_objectives;
+using objective::basic_matrix;
+
+/* A population of `size` uniform genomes of `n` genes. */
+template <typename T>
+individual::basic_population<T> random_population(size_t size, size_t n, size_t m,
+                                                  uint64_t seed) {
+    rng::xoshiro256ss gen(seed);
+    individual::basic_population<T> population(size, n, m);
+    for (size_t i = 0; i < size; i++) {
+        individual::genome_ref x = population.row(i);
+        rng::fill(gen, x.words());
+        x.trim();
+    }
+    return population;
+}
+
+/* One row compared to another, then one row compared to a block of rows per kernel. */
+template <typename T>
+void bench_dominance(bench::report &report, const bench::settings &s, const std::string &type,
+                     std::mt19937 &gen) {
+    const size_t rows = 1024;
+    for (size_t m : {2, 4, 8}) {
+        basic_matrix<T> objectives = random_objectives<T>(rows, m, 32, gen);
+        json params = {{"type", type}, {"m", m}, {"rows", rows}};
+        if (report.selected("dominance", "compare")) {
+            double ns = bench::time_per_op(s, rows - 1, [&] {
+                for (size_t i = 0; i + 1 < rows; i++)
+                    bench::keep(pareto::compare<T>(objectives[i], objectives[i + 1]));
+            });
+            report.add("dominance", "compare", params, "pair", ns);
+        }
+
+        pareto::column_block<T> block(objectives);
+        std::vector<individual::word_t> better(individual::words_for(rows));
+        std::vector<individual::word_t> worse(individual::words_for(rows));
+        for (pareto::kernel k : {pareto::kernel::scalar, pareto::kernel::avx2,
+                                 pareto::kernel::avx512}) {
+            std::string name = std::string("dominates_many_") + pareto::to_string(k);
+            if (!pareto::supported(k) || !report.selected("dominance", name))
+                continue;
+            double ns = bench::time_per_op(s, rows, [&] {
+                pareto::dominates_many<T>(k, objectives[rows / 2], block, better, worse);
+                bench::keep(better[0]);
+            });
+            report.add("dominance", name, params, "pair", ns);
+        }
+    }
+}
+
+/* Each sorting engine, through a `sorter` which keeps its storage. */
+void bench_sorting(bench::report &report, const bench::settings &s, std::mt19937 &gen) {
+    using sorting::strategy;
+    const std::vector<strategy> strategies{strategy::graph,        strategy::deb,
+                                           strategy::ens_ss,       strategy::ens_bs,
+                                           strategy::bi_objective, strategy::divide_conquer};
+    for (size_t m : {2, 4, 8}) {
+        for (size_t n : {200, 1000}) {
+            basic_matrix<uint16_t> objectives = random_objectives<uint16_t>(n, m, 32, gen);
+            sorting::sorter<uint16_t> fronts;
+            for (strategy engine : strategies) {
+                if (engine == strategy::bi_objective && m != 2)
+                    continue;
+                if (!report.selected("sorting", sorting::to_string(engine)))
+                    continue;
+                double ns = bench::time_per_op(s, 1, [&] {
+                    fronts.sort(objectives, engine);
+                    bench::keep(fronts.size());
+                });
+                report.add("sorting", sorting::to_string(engine), {{"m", m}, {"N", n}}, "sort",
+                           ns, {{"fronts", fronts.size()}});
+            }
+        }
+    }
+}
+
+/* The truncation of a front by the modified NSGA-II, which updates the
+   crowding distances after each removal. */
+void bench_crowding(bench::report &report, const bench::settings &s, std::mt19937 &gen) {
+    if (!report.selected("crowding", "dynamic_crowding_select"))
+        return;
+    for (size_t m : {2, 4}) {
+        for (size_t n : {200, 1000}) {
+            basic_matrix<double> objectives = random_objectives<double>(n, m, 1000, gen);
+            sorting::front_t front(n);
+            for (size_t i = 0; i < n; i++)
+                front[i] = i;
+            double ns = bench::time_per_op(s, 1, [&] {
+                bench::keep(modified_nsga2::dynamic_crowding_select(objectives, front, n / 2));
+            });
+            report.add("crowding", "dynamic_crowding_select", {{"m", m}, {"N", n}, {"keep", n / 2}},
+                       "front", ns);
+        }
+    }
+}
+
+/* Bit-wise mutation at rate 1/n, with and without recording the flipped genes. */
+void bench_mutation(bench::report &report, const bench::settings &s) {
+    for (size_t n : {64, 1024, 16384}) {
+        individual::individual_t x(n);
+        rng::xoshiro256ss gen(1);
+        mutation::bitwise bitwise(1.0 / n);
+        std::vector<size_t> flipped;
+        flipped.reserve(n);
+        if (report.selected("mutation", "bitwise")) {
+            double ns = bench::time_per_op(s, 1, [&] { bench::keep(bitwise(x, gen)); });
+            report.add("mutation", "bitwise", {{"n", n}}, "child", ns);
+        }
+        if (report.selected("mutation", "bitwise_flipped")) {
+            double ns = bench::time_per_op(s, 1, [&] {
+                flipped.clear();
+                bench::keep(bitwise(x, gen, flipped));
+            });
+            report.add("mutation", "bitwise_flipped", {{"n", n}}, "child", ns);
+        }
+    }
+}
+
+/* mLOTZ evaluated in batches, and from the value of a parent after a mutation. */
+void bench_evaluation(bench::report &report, const bench::settings &s) {
+    const size_t size = 512;
+    for (size_t n : {64, 1024}) {
+        for (size_t m : {2, 4, 8}) {
+            benchmark::mlotz_functor f(m);
+            auto population = random_population<uint16_t>(size, n, m, n + m);
+            basic_matrix<uint16_t> &values = population.objectives();
+            json params = {{"n", n}, {"m", m}};
+            if (report.selected("evaluation", "mlotz_batch")) {
+                double ns = bench::time_per_op(s, size, [&] {
+                    f.evaluate(population.view(), values.row_range(0, size));
+                    bench::keep(values[0][0]);
+                });
+                report.add("evaluation", "mlotz_batch", params, "genome", ns);
+            }
+            if (report.selected("evaluation", "mlotz_delta")) {
+                // Children of the first genome, one flip each
+                f.evaluate(population.view().subview(0, 1), values.row_range(0, 1));
+                individual::genome_ref child = population.row(1);
+                std::vector<uint16_t> value(m);
+                size_t flip = 0;
+                double ns = bench::time_per_op(s, 1, [&] {
+                    population.assign(1, population, 0);
+                    flip = (flip + 7919) % n;
+                    child.flip(flip);
+                    f.evaluate_delta(child.view(), values[0], std::span<const size_t>(&flip, 1),
+                                     std::span<uint16_t>(value));
+                    bench::keep(value[0]);
+                });
+                report.add("evaluation", "mlotz_delta", params, "child", ns);
+            }
+        }
+    }
+}
+
+/* Whole runs of the NSGA-II on mLOTZ, in generations per second. */
+void bench_generations(bench::report &report, size_t generations, size_t threads,
+                       const std::vector<size_t> &sizes) {
+    if (!report.selected("nsga2", "generations"))
+        return;
+    using experiment_t =
+        nsga2::NSGA2<rng::xoshiro256ss, objective::compact_val_t, profiling::recorder>;
+    for (size_t n : {64, 256}) {
+        for (size_t m : {2, 4, 8}) {
+            for (size_t N : sizes) {
+                auto f = objective::make_batch_objective<uint16_t>(benchmark::mlotz_functor(m));
+                experiment_t experiment(n, m, N, f, 1);
+                experiment.set_threads(threads);
+                auto start = bench::clock::now();
+                experiment.run(end_criteria::max_iterations(generations));
+                std::chrono::duration<double, std::nano> elapsed = bench::clock::now() - start;
+                // The time of each phase, from the profiler of the run
+                json phases = experiment.profile().to_json()["phases"];
+                report.add("nsga2", "generations",
+                           {{"n", n}, {"m", m}, {"N", N}, {"threads", threads}}, "generation",
+                           elapsed.count() / generations,
+                           {{"generations", generations}, {"phases", phases}});
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    using namespace cxxopts;
+    // clang-format off
+    cxxopts::Options options(argv[0], "Micro- and macro-benchmarks of the NSGA-II");
+    options.add_options()
+      ("json", "Save the results to this JSON file", value<std::string>())
+      ("filter", "Only run the benchmarks whose group/name contains this string",
+       value<std::string>()->default_value(""))
+      ("min_time", "Seconds per sample of a micro-benchmark",
+       value<double>()->default_value("0.05"))
+      ("repeats", "Samples per micro-benchmark, the best is kept",
+       value<size_t>()->default_value("3"))
+      ("generations", "Generations per run of the NSGA-II", value<size_t>()->default_value("200"))
+      ("population_sizes", "Population sizes of the runs of the NSGA-II",
+       value<std::vector<size_t>>()->default_value("100,500"))
+      ("threads", "Threads of the runs of the NSGA-II", value<size_t>()->default_value("1"))
+      ("seed", "Seed of the random inputs", value<uint32_t>()->default_value("0"))
+      ("h,help", "Print usage");
+    // clang-format on
+
+    auto result = options.parse(argc, argv);
+    if (result.count("help")) {
+        std::println("{0}", options.help());
+        return 0;
+    }
+
+    bench::settings s{.min_time = result["min_time"].as<double>(),
+                      .repeats = result["repeats"].as<size_t>()};
+    std::mt19937 gen(result["seed"].as<uint32_t>());
+    bench::report report(result["filter"].as<std::string>());
+
+    std::time_t now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+    report.describe("date", date);
+#if defined(__VERSION__)
+    report.describe("compiler", __VERSION__);
+#endif
+#if defined(NDEBUG)
+    report.describe("assertions", false);
+#else
+    report.describe("assertions", true);
+#endif
+    report.describe("dominance_kernel", pareto::to_string(pareto::best_kernel()));
+    report.describe("seed", result["seed"].as<uint32_t>());
+
+    bench_dominance<double>(report, s, "double", gen);
+    bench_dominance<uint16_t>(report, s, "uint16_t", gen);
+    bench_sorting(report, s, gen);
+    bench_crowding(report, s, gen);
+    bench_mutation(report, s);
+    bench_evaluation(report, s);
+    bench_generations(report, result["generations"].as<size_t>(), result["threads"].as<size_t>(),
+                      result["population_sizes"].as<std::vector<size_t>>());
+
+    if (result.count("json")) {
+        std::string filename = result["json"].as<std::string>();
+        report.save(filename);
+        std::println("Saved the results to {0}", filename);
+    }
+    return 0;
+}
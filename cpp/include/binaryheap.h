@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <concepts>
+#include <cstddef>
 #include <unordered_map>
 #include <vector>
 
@@ -26,6 +29,7 @@ namespace binary_heap {
             data.push_back(x);
             while (index > 0 && data[(index - 1) / 2] > data[index]) {
                 std::swap(data[(index - 1) / 2], data[index]);
+                index = (index - 1) / 2;
             }
         }
 
@@ -34,27 +38,31 @@ namespace binary_heap {
             int n = size();
             assert(n > 0);
 
-            T max = data[0];
+            T min = data[0];
 
             // Replace the root with the last element
             data[0] = data[n - 1];
+            data.pop_back();
+            n--;
 
             int i = 0;
             // Sift down this element until it is correctly placed
-            while (i < n - 1) {
-                int c1 = 2*i + 1;
-                int c2 = c1 + 1;
-                if (c1 < n && data[c1] < data[i]) {
-                    std::swap(data[c1], data[i]);
-                    i = c1;
-                } else if (c2 < n && data[c2] < data[i]) {
-                    std::swap(data[c2], data[i]);
-                    i = c2;
-                } else {
+            while (true) {
+                int c = 2*i + 1;
+                if (c >= n) {
                     break;
                 }
+                // Pick the child with the lower key
+                if (c + 1 < n && data[c + 1] < data[c]) {
+                    c++;
+                }
+                if (!(data[c] < data[i])) {
+                    break;
+                }
+                std::swap(data[c], data[i]);
+                i = c;
             }
-            return max;
+            return min;
         }
 
         /** The number of elements in the heap. */
@@ -105,10 +113,7 @@ namespace binary_heap {
             nodes.push_back(node);
             indices.emplace(node.id, index);
 
-            while (index > 0 && nodes[(index - 1) / 2].key > nodes[index].key) {
-                // Swap the node with its parent while the parent has a greater key
-                swap_nodes((index - 1) / 2, index);
-            }
+            sift_up(index);
         }
 
         /** Extract and return the minimum value of this binary heap. */
@@ -125,7 +130,10 @@ namespace binary_heap {
             nodes[0] = nodes[n - 1];
             nodes.pop_back();
 
-            sift_down(0);
+            if (n > 1) {
+                indices[nodes[0].id] = 0;
+                sift_down(0);
+            }
             return min;
         }
 
@@ -138,6 +146,20 @@ namespace binary_heap {
             sift_up(index);
         }
 
+        /** Increase the key of the element specified by `id`. */
+        void increase_key(I id, K new_key) {
+            assert(indices.find(id) != indices.end());
+            int index = indices[id];
+            assert(nodes[index].key <= new_key);
+            nodes[index].key = new_key;
+            sift_down(index);
+        }
+
+        /** Whether the element specified by `id` is in the heap. */
+        bool contains(I id) {
+            return indices.find(id) != indices.end();
+        }
+
         private:
 
         void swap_nodes(int i, int j) {
@@ -150,23 +172,24 @@ namespace binary_heap {
         /* Sift down this element until it is correctly placed. */
         void sift_down(int i) {
             int n = size();
-            while (i < n - 1) {
-                int c1 = 2*i + 1;
-                int c2 = c1 + 1;
-                // Swap the node with one of its children with a lower key
-                if (c1 < n && nodes[c1].key < nodes[i].key) {
-                    swap_nodes(c1, i);
-                    i = c1;
-                } else if (c2 < n && nodes[c2].key < nodes[i].key) {
-                    swap_nodes(c2, i);
-                    i = c2;
-                } else {
+            while (true) {
+                int c = 2*i + 1;
+                if (c >= n) {
+                    break;
+                }
+                // Swap the node with its child of lowest key if it is lower
+                if (c + 1 < n && nodes[c + 1].key < nodes[c].key) {
+                    c++;
+                }
+                if (!(nodes[c].key < nodes[i].key)) {
                     break;
                 }
+                swap_nodes(c, i);
+                i = c;
             }
         }
 
-        /* Sift down this element until it is correctly placed. */
+        /* Sift up this element until it is correctly placed. */
         void sift_up(int index) {
             while (index > 0) {
                 int parent = (index - 1) / 2;
@@ -178,5 +201,160 @@ namespace binary_heap {
             }
         }
     };
+
+    /**
+     * @brief A min-priority queue with dense indices implemented by a d-ary heap.
+     *
+     * @details This is a `BinaryHeap` for ids that are small non-negative
+     * integers, e.g. indices in a population. Positions are tracked in a plain
+     * vector indexed by id instead of a hash map, so moving a node costs two
+     * array writes. A 4-ary layout halves the depth of the heap and keeps the
+     * children of a node in the same cache line.
+     *
+     * @tparam K `Comparable` : key
+     * @tparam I `std::integral` : id, in [0, capacity)
+     * @tparam D arity of the heap
+     */
+    template <typename K, std::integral I, size_t D = 2>
+    class DenseHeap {
+        static_assert(D >= 2, "a heap has at least two children per node");
+
+        // Position of each id in `nodes`, or `absent`
+        std::vector<size_t> positions;
+        std::vector<Node<K, I>> nodes;
+
+        static constexpr size_t absent = static_cast<size_t>(-1);
+
+        public:
+
+        DenseHeap() : positions(), nodes() {}
+
+        /** A heap for the ids in [0, capacity), allocated once. */
+        explicit DenseHeap(size_t capacity) : positions(capacity, absent), nodes() {
+            nodes.reserve(capacity);
+        }
+
+        /** The number of elements in the heap. */
+        size_t size() const {
+            return nodes.size();
+        }
+
+        Node<K, I> &operator[](size_t i) {
+            return nodes[i];
+        }
+
+        /** Remove all elements, keeping the allocated memory. */
+        void clear() {
+            for (const Node<K, I> &node : nodes) {
+                positions[node.id] = absent;
+            }
+            nodes.clear();
+        }
+
+        /** Add an element in the heap. */
+        void emplace(Node<K, I> node) {
+            size_t id = static_cast<size_t>(node.id);
+            if (id >= positions.size()) {
+                positions.resize(id + 1, absent);
+            }
+            assert(positions[id] == absent);
+
+            size_t index = size();
+            nodes.push_back(node);
+            positions[id] = index;
+            sift_up(index);
+        }
+
+        /** Extract and return the minimum value of this heap. */
+        Node<K, I> extract_min() {
+            size_t n = size();
+            assert(n > 0);
+
+            Node<K, I> min = nodes[0];
+            positions[min.id] = absent;
+
+            // Replace the root with the last element
+            nodes[0] = nodes[n - 1];
+            nodes.pop_back();
+
+            if (n > 1) {
+                positions[nodes[0].id] = 0;
+                sift_down(0);
+            }
+            return min;
+        }
+
+        /** Decrease the key of the element specified by `id`. */
+        void decrease_key(I id, K new_key) {
+            assert(contains(id));
+            size_t index = positions[id];
+            assert(nodes[index].key >= new_key);
+            nodes[index].key = new_key;
+            sift_up(index);
+        }
+
+        /** Increase the key of the element specified by `id`. */
+        void increase_key(I id, K new_key) {
+            assert(contains(id));
+            size_t index = positions[id];
+            assert(nodes[index].key <= new_key);
+            nodes[index].key = new_key;
+            sift_down(index);
+        }
+
+        /** Whether the element specified by `id` is in the heap. */
+        bool contains(I id) const {
+            size_t i = static_cast<size_t>(id);
+            return i < positions.size() && positions[i] != absent;
+        }
+
+        private:
+
+        /* Sift down this element until it is correctly placed. */
+        void sift_down(size_t i) {
+            size_t n = size();
+            Node<K, I> node = nodes[i];
+            while (true) {
+                size_t first = D * i + 1;
+                if (first >= n) {
+                    break;
+                }
+                // Find the child with the lowest key
+                size_t c = first;
+                size_t last = std::min(first + D, n);
+                for (size_t j = first + 1; j < last; j++) {
+                    if (nodes[j].key < nodes[c].key) {
+                        c = j;
+                    }
+                }
+                if (!(nodes[c].key < node.key)) {
+                    break;
+                }
+                // Move the child up instead of swapping
+                nodes[i] = nodes[c];
+                positions[nodes[i].id] = i;
+                i = c;
+            }
+            nodes[i] = node;
+            positions[node.id] = i;
+        }
+
+        /* Sift up this element until it is correctly placed. */
+        void sift_up(size_t i) {
+            Node<K, I> node = nodes[i];
+            while (i > 0) {
+                size_t parent = (i - 1) / D;
+                if (nodes[parent].key <= node.key) {
+                    break;
+                }
+                // Move the parent down instead of swapping
+                nodes[i] = nodes[parent];
+                positions[nodes[i].id] = i;
+                i = parent;
+            }
+            nodes[i] = node;
+            positions[node.id] = i;
+        }
+    };
 } // namespace binary_heap
 
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "individual.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @namespace pareto
+ * @brief Batched dominance comparisons.
+ *
+ * @details `dominates_many` compares one objective value to a whole block of
+ * rows, several rows per instruction. The widest kernel supported by the CPU
+ * is selected at runtime, so the same binary runs on any x86-64 machine, and
+ * on other architectures the scalar kernel is used.
+ */
+namespace pareto {
+    using individual::word_t;
+    using objective::matrix_t;
+
+    /* The implementations of `dominates_many`, from the narrowest. */
+    enum class kernel {
+        scalar, // one row at a time
+        avx2,   // 256-bit registers: 4 doubles, 8 int32_t or 16 uint16_t
+        avx512, // 512-bit registers, with AVX-512F and AVX-512BW
+    };
+
+    /* Returns `true` if the CPU runs the kernel `k`. */
+    bool supported(kernel k);
+
+    /* The widest kernel run by the CPU, used by default. */
+    kernel best_kernel();
+
+    /* The name of a kernel. */
+    const char *to_string(kernel k);
+
+    /**
+     * @brief The objective values of a block of rows, stored column by column.
+     *
+     * @details Each column holds `stride()` values, a multiple of 64, so that
+     * the kernels load whole registers and fill whole words of bits. The
+     * padding values are zero and their bits are cleared by the kernels.
+     *
+     * @tparam T `double`, `int32_t` or `uint16_t`.
+     */
+    template <typename T>
+    class column_block {
+      public:
+        column_block() = default;
+        explicit column_block(const objective::basic_matrix<T> &objectives) {
+            assign(objectives);
+        }
+
+        /* Copy the rows of `objectives`, reusing the storage of the block. */
+        void assign(const objective::basic_matrix<T> &objectives);
+
+        size_t rows() const { return rows_; }
+        size_t cols() const { return cols_; }
+        size_t stride() const { return stride_; }
+
+        /* The values of the `k`-th objective, padded to `stride()`. */
+        const T *column(size_t k) const { return data_.data() + k * stride_; }
+
+      private:
+        std::vector<T> data_;
+        size_t rows_ = 0;
+        size_t cols_ = 0;
+        size_t stride_ = 0;
+    };
+
+    /**
+     * @brief Compare `point` to every row of `block`.
+     *
+     * @details Bit `j` of `better` is set if `point` strictly dominates the
+     * row `j`, and bit `j` of `worse` if the row `j` strictly dominates
+     * `point`, with the bit order of `individual::genome`. Both spans hold
+     * `individual::words_for(block.rows())` words, which are overwritten.
+     */
+    template <typename T>
+    void dominates_many(std::span<const T> point, const column_block<T> &block,
+                        std::span<word_t> better, std::span<word_t> worse);
+
+    /* Same as above with the kernel `k`, which must be supported. */
+    template <typename T>
+    void dominates_many(kernel k, std::span<const T> point, const column_block<T> &block,
+                        std::span<word_t> better, std::span<word_t> worse);
+
+    // Instantiated in dominance.cpp
+    extern template class column_block<double>;
+    extern template class column_block<int32_t>;
+    extern template class column_block<uint16_t>;
+} // namespace pareto
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "individual.h"
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace objective {
+
+    /**
+     * @brief An objective evaluated on a batch of genomes at a time.
+     *
+     * @details `e.evaluate(genomes, values)` writes the value of `genomes[i]`
+     * to `values[i * m .. (i + 1) * m)` where `m = e.objectives()`, i.e. to
+     * consecutive rows of a preallocated `basic_matrix<T>`, as given by
+     * `basic_matrix::row_range`. The genomes are rows of a population, read
+     * in place through an `individual::population_view`. Called through this
+     * concept, the dispatch is static and the per-genome work can be inlined.
+     */
+    template <typename E, typename T>
+    concept batch_evaluator = requires(const E &e, individual::population_view genomes,
+                                       std::span<T> values) {
+        { e.objectives() } -> std::convertible_to<size_t>;
+        e.evaluate(genomes, values);
+    };
+
+    /**
+     * @brief A `batch_evaluator` which also evaluates a child from the value
+     * of its parent.
+     *
+     * @details `e.evaluate_delta(child, parent, flipped, value)` writes to
+     * `value` the value of `child`, which differs from a parent of value
+     * `parent` exactly at the genes `flipped`, in increasing order. It must
+     * give the same value as `evaluate`, at a cost which should depend on
+     * the flipped genes rather than on the size of the genome.
+     */
+    template <typename E, typename T>
+    concept delta_evaluator =
+        batch_evaluator<E, T> &&
+        requires(const E &e, const individual::genome_view &child, std::span<const T> parent,
+                 std::span<const size_t> flipped, std::span<T> value) {
+            e.evaluate_delta(child, parent, flipped, value);
+        };
+
+    /**
+     * @brief A batch objective behind a virtual interface, which costs one
+     * virtual call per batch rather than one per genome.
+     */
+    template <typename T>
+    class basic_batch_objective {
+      public:
+        virtual ~basic_batch_objective() = default;
+
+        /* The number of objectives. */
+        virtual size_t objectives() const = 0;
+
+        /* Writes the values of `genomes` to consecutive rows of `values`. */
+        virtual void evaluate(individual::population_view genomes,
+                              std::span<T> values) const = 0;
+
+        /* Whether `evaluate_delta` is implemented. */
+        virtual bool has_delta() const { return false; }
+
+        /* As `delta_evaluator`, when `has_delta()`. */
+        virtual void evaluate_delta(const individual::genome_view & /* child */,
+                                    std::span<const T> /* parent */,
+                                    std::span<const size_t> /* flipped */,
+                                    std::span<T> /* value */) const {
+            throw std::logic_error("evaluate_delta: not implemented by this objective");
+        }
+    };
+
+    /* A `batch_evaluator` behind the virtual interface, with its
+       `evaluate_delta` if it is a `delta_evaluator`. */
+    template <typename T, batch_evaluator<T> E>
+    class batch_objective final : public basic_batch_objective<T> {
+        E e;
+
+      public:
+        explicit batch_objective(E e) : e(std::move(e)) {}
+
+        size_t objectives() const override { return e.objectives(); }
+
+        void evaluate(individual::population_view genomes, std::span<T> values) const override {
+            e.evaluate(genomes, values);
+        }
+
+        bool has_delta() const override { return delta_evaluator<E, T>; }
+
+        void evaluate_delta(const individual::genome_view &child, std::span<const T> parent,
+                            std::span<const size_t> flipped, std::span<T> value) const override {
+            if constexpr (delta_evaluator<E, T>)
+                e.evaluate_delta(child, parent, flipped, value);
+            else
+                basic_batch_objective<T>::evaluate_delta(child, parent, flipped, value);
+        }
+    };
+
+    /* An objective function returning values of type `V`, called once per
+       genome. Each batch is copied genome by genome into one `individual_t`,
+       which is allocated once per batch. */
+    template <typename T, typename V>
+    class function_objective final : public basic_batch_objective<T> {
+        basic_fn_t<V> f;
+        size_t m;
+
+      public:
+        function_objective(basic_fn_t<V> f, size_t m) : f(std::move(f)), m(m) {}
+
+        size_t objectives() const override { return m; }
+
+        void evaluate(individual::population_view genomes, std::span<T> values) const override {
+            assert(values.size() == genomes.size() * m);
+            individual_t x(genomes.genes());
+            for (size_t i = 0; i < genomes.size(); i++) {
+                const individual::word_t *words = genomes[i].data();
+                std::copy(words, words + x.words().size(), x.words().begin());
+                V v = f(x);
+                assert(v.size() == m);
+                std::copy(v.begin(), v.end(), values.begin() + i * m);
+            }
+        }
+    };
+
+    /* Shares a `batch_evaluator` behind the virtual interface. */
+    template <typename T, batch_evaluator<T> E>
+    std::shared_ptr<const basic_batch_objective<T>> make_batch_objective(E e) {
+        return std::make_shared<const batch_objective<T, E>>(std::move(e));
+    }
+
+} // namespace objective
@@ -1,43 +1,366 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
 #include <compare>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <initializer_list>
 #include <iostream>
 #include <span>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 /* Individual values. */
 namespace individual {
-    // FIXME: use char instead of bool in order to avoid
-    // std::vector<bool> specialization which breaks std::span.
-    // This works thanks to automatic char -> bool coercion.
-    // Unfortunately, that means invalid individuals can be constructed.
-    // Can this be fixed by using another data structure?
-
-    // Comment:
-    // 1. I think this does not matter if we define non-zero values
-    // as true and zero values as false. This way, we can still well define
-    // the individuals. For the operators, we can tweak them using bitwise
-    // operations to make sure that the values are either 0 or 1. But this
-    // will make the operators less efficient.
-
-    // 2. Another way is to override the constructor of the individual_t class
-    // to make sure that the values are either 0 or 1 on construction.
-    // And use std::move when constructing a new individual_t object from
-    // std::vector<uint8_t> object. But this is not worth the cost since it
-    // takes too much time.
+    /* A machine word holding `word_bits` packed genes. */
+    using word_t = std::uint64_t;
+
+    constexpr size_t word_bits = 64;
+
+    /* The number of words needed to hold `n` packed genes. */
+    constexpr size_t words_for(size_t n) { return (n + word_bits - 1) / word_bits; }
+
+    /**
+     * @brief The unpacked representation of an individual, one gene per byte.
+     *
+     * This was the storage of `individual_t` before genomes were packed and is
+     * kept for I/O and for interoperability with byte-oriented code.
+     */
+    using bytes_t = std::vector<uint8_t>;
+
+    /**
+     * @brief A read-only, span-like view over a range of packed genes.
+     *
+     * @details Gene `i` of the view lives at bit `(offset + i) % 64` of the
+     * word `(offset + i) / 64`, so sub-views need not be word-aligned.
+     */
+    class genome_view {
+        const word_t *words_ = nullptr;
+        size_t offset_ = 0;
+        size_t size_ = 0;
+
+      public:
+        /* Iterates over packed genes as booleans. */
+        class iterator {
+            const word_t *words_;
+            size_t bit_;
+
+          public:
+            using value_type = bool;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() : words_(nullptr), bit_(0) {}
+            iterator(const word_t *words, size_t bit) : words_(words), bit_(bit) {}
+
+            bool operator*() const { return (words_[bit_ / word_bits] >> (bit_ % word_bits)) & 1; }
+            iterator &operator++() {
+                ++bit_;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator it = *this;
+                ++bit_;
+                return it;
+            }
+            bool operator==(const iterator &other) const { return bit_ == other.bit_; }
+        };
+
+        genome_view() = default;
+        genome_view(const word_t *words, size_t offset, size_t size)
+            : words_(words), offset_(offset), size_(size) {}
+
+        /* The number of genes in the view. */
+        size_t size() const { return size_; }
+
+        /* The words backing the view, starting at the word holding gene 0. */
+        const word_t *data() const { return words_; }
+
+        /* The bit position of gene 0 inside `data()[0]`. */
+        size_t offset() const { return offset_; }
+
+        bool operator[](size_t i) const {
+            size_t bit = offset_ + i;
+            return (words_[bit / word_bits] >> (bit % word_bits)) & 1;
+        }
+
+        /* A view of `count` genes starting at gene `offset`. */
+        genome_view subspan(size_t offset, size_t count) const {
+            size_t bit = offset_ + offset;
+            return genome_view(words_ + bit / word_bits, bit % word_bits, count);
+        }
+
+        iterator begin() const { return iterator(words_, offset_); }
+        iterator end() const { return iterator(words_, offset_ + size_); }
+    };
+
+    /**
+     * @brief The gene-level operations shared by `genome`, `static_genome`
+     * and `genome_ref`.
+     *
+     * @details `Derived` provides `size()` and `words()`, its packed words,
+     * gene `i` being stored at bit `i % 64` of word `i / 64`.
+     */
+    template <typename Derived>
+    class genome_bits {
+        Derived &self() { return static_cast<Derived &>(*this); }
+        const Derived &self() const { return static_cast<const Derived &>(*this); }
+
+      public:
+        bool operator[](size_t i) const { return test(i); }
+
+        bool test(size_t i) const {
+            return (self().words()[i / word_bits] >> (i % word_bits)) & 1;
+        }
+
+        void set(size_t i, bool value = true) {
+            word_t mask = word_t(1) << (i % word_bits);
+            if (value) {
+                self().words()[i / word_bits] |= mask;
+            } else {
+                self().words()[i / word_bits] &= ~mask;
+            }
+        }
+
+        void flip(size_t i) { self().words()[i / word_bits] ^= word_t(1) << (i % word_bits); }
+
+        /* Flips every gene in place. */
+        Derived &flip() {
+            for (word_t &word : self().words())
+                word = ~word;
+            trim();
+            return self();
+        }
+
+        /* The number of genes set to one. */
+        size_t count() const {
+            size_t ones = 0;
+            for (word_t word : self().words())
+                ones += std::popcount(word);
+            return ones;
+        }
+
+        /* Clears the unused high bits of the last word, which must be done
+           after writing to `words()` directly. */
+        void trim() {
+            size_t size = self().size();
+            if (size % word_bits != 0)
+                self().words()[size / word_bits] &= (word_t(1) << (size % word_bits)) - 1;
+        }
+
+        bool operator==(const genome_bits &) const = default;
+    };
+
+    /**
+     * @brief A bit string packed into 64-bit words.
+     *
+     * @details Gene `i` is stored at bit `i % 64` of word `i / 64`. The unused
+     * high bits of the last word are always zero, so that word-wise
+     * comparisons and population counts need no masking.
+     */
+    class genome : public genome_bits<genome> {
+        std::vector<word_t> words_;
+        size_t size_ = 0;
+
+      public:
+        genome() = default;
+
+        /* A genome of `n` genes all set to `value`. */
+        explicit genome(size_t n, bool value = false)
+            : words_(words_for(n), value ? ~word_t(0) : word_t(0)), size_(n) {
+            trim();
+        }
+
+        /* Builds a genome from its genes, where any non-zero value is a one. */
+        genome(std::initializer_list<uint8_t> genes);
+
+        /* Packs the byte form of an individual. */
+        explicit genome(const bytes_t &genes);
+
+        /* The number of genes. */
+        size_t size() const { return size_; }
+
+        /* Resizes the genome, new genes being set to zero. */
+        void resize(size_t n) {
+            words_.resize(words_for(n), 0);
+            size_ = n;
+            trim();
+        }
+
+        /* The packed words. */
+        std::span<const word_t> words() const { return words_; }
+        std::span<word_t> words() { return words_; }
+
+        /* A view over the whole genome. */
+        genome_view view() const { return genome_view(words_.data(), 0, size_); }
+        operator genome_view() const { return view(); }
+
+        genome_view::iterator begin() const { return genome_view::iterator(words_.data(), 0); }
+        genome_view::iterator end() const { return genome_view::iterator(words_.data(), size_); }
+
+        /* In-place word-wise bitwise operators. These never allocate. */
+        genome &operator&=(const genome &other);
+        genome &operator|=(const genome &other);
+        genome &operator^=(const genome &other);
+
+        bool operator==(const genome &other) const = default;
+    };
+
+    /**
+     * @brief A genome of `N` genes, `N` being known at compile time.
+     *
+     * @details The words live in a `std::array`, so loops over the genes or
+     * the words have a constant trip count and no allocation is needed. The
+     * bit order and the interface are those of `genome`.
+     */
+    template <size_t N>
+    class static_genome : public genome_bits<static_genome<N>> {
+        static constexpr size_t n_words = words_for(N);
+        std::array<word_t, n_words> words_{};
+
+      public:
+        /* The number of genes. */
+        static constexpr size_t size() { return N; }
+
+        /* The packed words. */
+        std::span<const word_t, n_words> words() const { return words_; }
+        std::span<word_t, n_words> words() { return words_; }
+
+        /* A view over the whole genome. */
+        genome_view view() const { return genome_view(words_.data(), 0, N); }
+        operator genome_view() const { return view(); }
+
+        /* A copy as a runtime-sized genome. */
+        genome to_genome() const {
+            genome out(N);
+            std::copy(words_.begin(), words_.end(), out.words().begin());
+            return out;
+        }
+
+        bool operator==(const static_genome &other) const = default;
+    };
+
+    /**
+     * @brief A mutable genome whose words are owned elsewhere, e.g. a row of
+     * a `basic_population`.
+     *
+     * @details The bit order and the interface are those of `genome`, so the
+     * mutation operators work on it in place.
+     */
+    class genome_ref : public genome_bits<genome_ref> {
+        word_t *words_;
+        size_t size_;
+
+      public:
+        genome_ref(word_t *words, size_t size) : words_(words), size_(size) {}
+
+        /* The number of genes. */
+        size_t size() const { return size_; }
+
+        /* The packed words. */
+        std::span<word_t> words() const { return std::span<word_t>(words_, words_for(size_)); }
+
+        /* A view over the whole genome. */
+        genome_view view() const { return genome_view(words_, 0, size_); }
+        operator genome_view() const { return view(); }
+    };
+
+    /**
+     * @brief A read-only view over the genomes of a population stored in one
+     * buffer, each `stride()` words after the previous one.
+     *
+     * @details Iterating it yields a `genome_view` per individual, so a
+     * population is scanned without copying its genomes.
+     */
+    class population_view {
+        const word_t *words_ = nullptr;
+        size_t size_ = 0;
+        size_t genes_ = 0;
+        size_t stride_ = 0;
+
+      public:
+        /* Iterates over the genomes as `genome_view`s. */
+        class iterator {
+            const word_t *words_;
+            size_t genes_;
+            size_t stride_;
+
+          public:
+            using value_type = genome_view;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() : words_(nullptr), genes_(0), stride_(0) {}
+            iterator(const word_t *words, size_t genes, size_t stride)
+                : words_(words), genes_(genes), stride_(stride) {}
+
+            genome_view operator*() const { return genome_view(words_, 0, genes_); }
+            iterator &operator++() {
+                words_ += stride_;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator it = *this;
+                words_ += stride_;
+                return it;
+            }
+            bool operator==(const iterator &other) const { return words_ == other.words_; }
+        };
+
+        population_view() = default;
+        population_view(const word_t *words, size_t size, size_t genes, size_t stride)
+            : words_(words), size_(size), genes_(genes), stride_(stride) {}
+
+        /* The number of individuals. */
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        /* The number of genes of an individual. */
+        size_t genes() const { return genes_; }
+
+        /* The number of words from an individual to the next. */
+        size_t stride() const { return stride_; }
+
+        /* The words of all the genomes, `stride()` per individual. */
+        std::span<const word_t> words() const {
+            return std::span<const word_t>(words_, size_ * stride_);
+        }
+
+        genome_view operator[](size_t i) const {
+            return genome_view(words_ + i * stride_, 0, genes_);
+        }
+
+        /* A view of `count` individuals starting at the `first`-th. */
+        population_view subview(size_t first, size_t count) const {
+            assert(first + count <= size_);
+            return population_view(words_ + first * stride_, count, genes_, stride_);
+        }
+
+        iterator begin() const { return iterator(words_, genes_, stride_); }
+        iterator end() const { return iterator(words_ + size_ * stride_, genes_, stride_); }
+    };
+
     /**
      * @brief An individual, which represents a possible solution
      * to an optimization problem.
      *
-     * An individual is a bit string, i.e a vector of booleans.
+     * An individual is a bit string, packed 64 genes per word.
      */
-    using individual_t = std::vector<uint8_t>;
+    using individual_t = genome;
 
     using population_t = std::vector<individual_t>;
 
-    /* An `individual_t` span. */
-    using span = std::span<const uint8_t>;
+    /* An `individual_t` view. */
+    using span = genome_view;
+
+    /* Unpacks an individual into its byte form. */
+    bytes_t to_bytes(const individual_t &x);
+
+    /* Packs the byte form of an individual. */
+    individual_t from_bytes(const bytes_t &x);
 
     /* Converts an individual to an integer in big-endian format. */
     size_t to_bits_be(const individual_t &x);
@@ -46,7 +369,7 @@ namespace individual {
     size_t to_bits_le(const individual_t &x);
 
     /* Converts an individual to a string. */
-    std::string to_string(const individual_t &x);
+    std::string to_string(const genome_view &x);
 
     individual_t operator&(const individual_t &a, const individual_t &b);
 
@@ -56,7 +379,7 @@ namespace individual {
 
     individual_t operator~(const individual_t &a);
 
-    std::ostream &operator<<(std::ostream &os, const individual_t &v);
+    std::ostream &operator<<(std::ostream &os, const genome_view &v);
 } // namespace individual
 
 /* Objective values. */
@@ -66,6 +389,56 @@ namespace objective {
     /* An multi-objective value is a floating-point vector. */
     using val_t = std::vector<double>;
 
+    /**
+     * @brief A vector of at most `Capacity` values stored inline.
+     *
+     * @details Used as an objective value, it needs no heap allocation per
+     * evaluation, and small integer types make exact comparisons.
+     */
+    template <typename T, size_t Capacity>
+    class inline_vector {
+        std::array<T, Capacity> data_{};
+        size_t size_ = 0;
+
+      public:
+        using value_type = T;
+
+        inline_vector() = default;
+        explicit inline_vector(size_t n, T value = T()) { resize(n, value); }
+        inline_vector(std::initializer_list<T> values) {
+            resize(values.size());
+            std::copy(values.begin(), values.end(), data_.begin());
+        }
+
+        static constexpr size_t capacity() { return Capacity; }
+        size_t size() const { return size_; }
+
+        /* Resizes to `n <= Capacity` values, new values being `value`. */
+        void resize(size_t n, T value = T()) {
+            if (n > Capacity)
+                throw std::length_error("inline_vector: size exceeds the capacity");
+            for (size_t i = size_; i < n; i++)
+                data_[i] = value;
+            size_ = n;
+        }
+
+        T *data() { return data_.data(); }
+        const T *data() const { return data_.data(); }
+        T &operator[](size_t i) { return data_[i]; }
+        const T &operator[](size_t i) const { return data_[i]; }
+        T *begin() { return data_.data(); }
+        T *end() { return data_.data() + size_; }
+        const T *begin() const { return data_.data(); }
+        const T *end() const { return data_.data() + size_; }
+
+        bool operator==(const inline_vector &other) const {
+            return std::equal(begin(), end(), other.begin(), other.end());
+        }
+    };
+
+    /* A compact objective value for at most 16 objectives below 65536, e.g. mLOTZ. */
+    using compact_val_t = inline_vector<uint16_t, 16>;
+
     /**
      * @brief An objective function that returns an objective value
      * from an individual.
@@ -82,7 +455,68 @@ namespace objective {
      * objective::val_t (*f)(individual_t&) = +[](individual_t x) { ... };
      * ```
      */
-    using fn_t = std::function<val_t(const individual_t &)>;
+    template <typename V>
+    using basic_fn_t = std::function<V(const individual_t &)>;
+    using fn_t = basic_fn_t<val_t>;
+
+    /* A read-only view of an objective value, e.g. a row of a `matrix_t`. */
+    using row_t = std::span<const double>;
+
+    /**
+     * @brief The objective values of a population, stored contiguously.
+     *
+     * @details Row `i` holds the objective value of the `i`-th individual, so
+     * that each individual is evaluated once and every later comparison reads
+     * its cached value instead of calling the objective function again.
+     *
+     * @tparam T The type of a single objective, e.g. `double` or, for integer
+     * benchmarks, `uint16_t` which packs four times more rows into the cache.
+     */
+    template <typename T>
+    class basic_matrix {
+        std::vector<T> data_;
+        size_t rows_ = 0;
+        size_t cols_ = 0;
+
+      public:
+        using value_type = T;
+        using row_type = std::span<const T>;
+
+        basic_matrix() = default;
+        basic_matrix(size_t rows, size_t cols) : data_(rows * cols), rows_(rows), cols_(cols) {}
+
+        /* The number of individuals. */
+        size_t rows() const { return rows_; }
+
+        /* The number of objectives. */
+        size_t cols() const { return cols_; }
+
+        /* Resizes to `rows` rows, keeping the values of the leading rows. */
+        void resize(size_t rows) {
+            data_.resize(rows * cols_);
+            rows_ = rows;
+        }
+
+        row_type operator[](size_t i) const { return row_type(data_.data() + i * cols_, cols_); }
+        std::span<T> row(size_t i) { return std::span<T>(data_.data() + i * cols_, cols_); }
+
+        /* The values of the rows `first` to `first + count`, which are contiguous. */
+        std::span<T> row_range(size_t first, size_t count) {
+            assert(first + count <= rows_);
+            return std::span<T>(data_.data() + first * cols_, count * cols_);
+        }
+
+        /* Stores `v` as the value of the `i`-th individual. */
+        void assign(size_t i, std::span<const T> v) {
+            assert(v.size() == cols_);
+            std::copy(v.begin(), v.end(), data_.begin() + i * cols_);
+        }
+        void assign(size_t i, std::initializer_list<T> v) {
+            assign(i, std::span<const T>(v.begin(), v.size()));
+        }
+    };
+
+    using matrix_t = basic_matrix<double>;
 
     std::ostream &operator<<(std::ostream &os, const val_t &v);
 } // namespace objective
@@ -92,17 +526,55 @@ namespace pareto {
     using individual::individual_t;
     using objective::val_t;
 
+    using objective::row_t;
+
     using order = std::partial_ordering;
 
-    order compare(const val_t &a, const val_t &b);
+    /* Pareto-compares two objective values of the same size. */
+    template <typename T>
+    order compare(std::span<const T> a, std::span<const T> b) {
+        size_t n = a.size();
+        assert(n == b.size());
+
+        order out = order::equivalent;
+        for (size_t i = 0; i < n; ++i) {
+            T ai = a[i];
+            T bi = b[i];
+            if (ai == bi) {
+                continue;
+            }
+            order cmp = ai <=> bi;
+            if (out != order::equivalent && cmp != out) {
+                return order::unordered;
+            }
+            out = cmp;
+        }
+        return out;
+    }
+
+    /* Returns `true` if the left objective value strictly Pareto-dominates
+        the right value. */
+    template <typename T>
+    bool strictly_dominates(std::span<const T> a, std::span<const T> b) {
+        return compare(a, b) > 0;
+    }
+
+    /* Returns `true` if the left objective value Pareto-dominates
+        the right value. */
+    template <typename T>
+    bool dominates(std::span<const T> a, std::span<const T> b) {
+        return compare(a, b) >= 0;
+    }
+
+    order compare(row_t a, row_t b);
 
     /* Returns `true` if the left objective value strictly Pareto-dominates
         the right value. */
-    bool strictly_dominates(const val_t &a, const val_t &b);
+    bool strictly_dominates(row_t a, row_t b);
 
     /* Returns `true` if the left objective value Pareto-dominates
         the right value. */
-    bool dominates(const val_t &a, const val_t &b);
+    bool dominates(row_t a, row_t b);
 } // namespace pareto
 
 namespace individual {
@@ -1 +1,35 @@
-#pragma once
\ No newline at end of file
+#pragma once
+
+#include "individual.h"
+#include "sorting.h"
+#include <cstddef>
+
+/**
+ * @namespace modified_nsga2
+ * @brief The modified NSGA-II, which updates crowding distances dynamically
+ * during selection.
+ */
+namespace modified_nsga2 {
+    using matrix_t = objective::matrix_t;
+    using front_t = sorting::front_t;
+
+    /**
+     * @brief Truncate a front to `keep` individuals by removing the individual
+     * with the smallest crowding distance one at a time.
+     *
+     * @details After each removal, only the crowding distances of the removed
+     * individual's neighbours in each objective change. They are recomputed
+     * and updated in a `binary_heap::DenseHeap`, so the whole truncation runs
+     * in O(mNlogN) instead of recomputing every distance after each removal.
+     * Distances are normalized by the range of each objective over the whole
+     * front, as in `nsga2::crowding_distance`.
+     *
+     * @param objectives The cached values of the total population.
+     * @param front The indices of the individuals in the front.
+     * @param keep The number of individuals to keep.
+     * @return front_t The indices of the kept individuals.
+     */
+    template <typename T>
+    front_t dynamic_crowding_select(const objective::basic_matrix<T> &objectives,
+                                    const front_t &front, const size_t keep);
+} // namespace modified_nsga2
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "individual.h"
+#include "rng.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @namespace mutation
+ * @brief Mutation operators on packed individuals.
+ */
+namespace mutation {
+    using individual::individual_t;
+
+    /**
+     * @brief Standard bit-wise mutation: flip each gene independently with
+     * probability `rate`.
+     *
+     * @details Instead of one Bernoulli draw per gene, the gaps between two
+     * flipped genes are drawn from a geometric distribution of parameter
+     * `rate`, which gives exactly the same distribution of offspring. The cost
+     * is proportional to the number of flipped genes, i.e. about one draw per
+     * offspring when `rate` is 1/n. When `rate` is 2^-k for a small k, masks
+     * of flipped genes are built instead from k bulk-filled random words per
+     * 64 genes.
+     */
+    class bitwise {
+        double rate;
+        std::geometric_distribution<size_t> gap;
+        // When `rate` is 2^-k for a small k, the number k of random words
+        // ANDed together to build a mask of flipped genes, and 0 otherwise
+        int rounds = 0;
+
+        // Largest k for which masks are cheaper than skip sampling
+        static constexpr int max_rounds = 4;
+
+      public:
+        explicit bitwise(const double rate)
+            : rate(rate), gap(rate > 0.0 && rate < 1.0 ? rate : 0.5) {
+            int exponent;
+            if (rate > 0.0 && std::frexp(rate, &exponent) == 0.5 && 1 - exponent <= max_rounds)
+                rounds = 1 - exponent;
+        }
+
+        /**
+         * @brief Mutate `x` in place.
+         *
+         * @tparam Genome `individual_t` or an `individual::static_genome`.
+         * @return size_t The number of flipped genes.
+         */
+        template <typename Genome, typename Gen>
+        size_t operator()(Genome &x, Gen &gen) { return mutate(x, gen, ignore()); }
+
+        /**
+         * @brief Same as above, and append the positions of the flipped genes
+         * to `flipped` in increasing order.
+         *
+         * @details The random draws are those of the overload above, so both
+         * give the same offspring for the same generator.
+         */
+        template <typename Genome, typename Gen>
+        size_t operator()(Genome &x, Gen &gen, std::vector<size_t> &flipped) {
+            return mutate(x, gen, [&flipped](size_t j) { flipped.push_back(j); });
+        }
+
+      private:
+        /* Records no flipped position. */
+        struct ignore {
+            void operator()(size_t) const {}
+        };
+
+        template <typename Genome, typename Gen, typename Record>
+        size_t mutate(Genome &x, Gen &gen, Record record) {
+            size_t n = x.size();
+            if (rate <= 0.0)
+                return 0;
+            if (rate >= 1.0) {
+                x.flip();
+                if constexpr (!std::is_same_v<Record, ignore>) {
+                    for (size_t j = 0; j < n; j++)
+                        record(j);
+                }
+                return n;
+            }
+            if (rounds > 0)
+                return flip_masks(x, gen, record);
+            size_t flips = 0;
+            // Position of the next flipped gene
+            for (size_t j = gap(gen); j < n; j += gap(gen) + 1) {
+                x.flip(j);
+                record(j);
+                flips++;
+            }
+            return flips;
+        }
+
+        /* Each gene flips iff `rounds` independent random bits are all ones,
+           i.e. with probability 2^-rounds, drawing 64 genes per word. */
+        template <typename Genome, typename Gen, typename Record>
+        size_t flip_masks(Genome &x, Gen &gen, Record &record) {
+            using individual::word_t;
+            constexpr size_t block = 16;
+            std::span<word_t> words = x.words();
+            size_t flips = 0;
+            for (size_t w = 0; w < words.size(); w += block) {
+                size_t len = std::min(block, words.size() - w);
+                std::array<word_t, block> mask, bits;
+                rng::fill(gen, std::span(mask).first(len));
+                for (int r = 1; r < rounds; r++) {
+                    rng::fill(gen, std::span(bits).first(len));
+                    for (size_t i = 0; i < len; i++)
+                        mask[i] &= bits[i];
+                }
+                // No flips beyond the last gene
+                if (w + len == words.size() && x.size() % individual::word_bits != 0)
+                    mask[len - 1] &= (word_t(1) << (x.size() % individual::word_bits)) - 1;
+                for (size_t i = 0; i < len; i++) {
+                    words[w + i] ^= mask[i];
+                    flips += std::popcount(mask[i]);
+                    if constexpr (!std::is_same_v<Record, ignore>) {
+                        for (word_t bits = mask[i]; bits != 0; bits &= bits - 1)
+                            record((w + i) * individual::word_bits + std::countr_zero(bits));
+                    }
+                }
+            }
+            return flips;
+        }
+    };
+} // namespace mutation
@@ -1,11 +1,20 @@
 #pragma once
 
+#include "evaluation.h"
 #include "individual.h"
+#include "mutation.h"
+#include "population.h"
+#include "profiling.h"
+#include "rng.h"
+#include "sorting.h"
+#include "thread_pool.h"
 #include "utils.h"
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <random>
-#include <unordered_map>
+#include <span>
+#include <vector>
 
 /**
  * @namespace nsga2
@@ -18,29 +27,141 @@ namespace nsga2 {
     using population_t = individual::population_t; // vector of individuals
     using fn_t = objective::fn_t;                  // objective function
     using val_t = objective::val_t;                // value type
+    using matrix_t = objective::matrix_t;          // cached values of a population
 
-    using index_t = std::size_t;                          // index of an individual in a population
+    using index_t = sorting::index_t;                     // index of an individual in a population
     using rank_t = std::size_t;                           // rank of an individual in a population
-    using front_t = std::vector<index_t>;                 // front of the same rank
-    using fronts_t = std::vector<front_t>;                // list of fronts
-    using scores_t = std::unordered_map<index_t, double>; // crowding distance
+    using front_t = sorting::front_t;                     // front of the same rank
+    using fronts_t = sorting::fronts_t;                   // list of fronts
+    using scores_t = std::vector<double>; // crowding distance of each position of a front
 
     using criterion_t = end_criteria::criterion_t; // callable termination condition
 
+    /* How the front that does not entirely fit in the next generation is truncated. */
+    enum class selection_t {
+        crowding_distance, // keep the largest crowding distances, computed once
+        dynamic,           // remove the smallest crowding distance one at a time (modified NSGA-II)
+    };
+
+    /* The scratch of the selection, reused from one generation to the next. */
+    struct selection_buffers {
+        front_t selected;            // the survivors
+        front_t last_front;          // the front truncated by the dynamic selection
+        scores_t distances;          // the crowding distance of each position of a front
+        std::vector<double> columns; // the values of a front, one column per objective
+        std::vector<size_t> order;   // positions in a front
+
+        /* Reserve room for `population_size` parents and as many children. */
+        void reserve(size_t population_size, size_t objective_size);
+    };
+
+    /**
+     * @brief Calculate the crowding distance for each individual in the front.
+     *
+     * @param objectives The cached values of the total population.
+     * @param front the list of indices of the individuals in the front.
+     * @return The distance of `front[p]` at position `p`, held by
+     * `buffers.distances`, with the positions sorted by the last objective in
+     * `buffers.order`.
+     */
+    template <typename T>
+    const scores_t &crowding_distance(const objective::basic_matrix<T> &objectives,
+                                      std::span<const index_t> front, selection_buffers &buffers);
+
+    /**
+     * @brief Select `target_size` survivors from the sorted `fronts` into
+     * `buffers.selected`.
+     *
+     * @details Whole fronts are kept while they fit, then the next front is
+     * truncated as `selection` says. The survivors from `selected[crowded]`
+     * on, where `crowded` is returned, were kept by crowding distance, and
+     * the `i`-th of them has the distance `distances[order[i - crowded]]`.
+     * Times the crowding distances and records the truncated front with
+     * `profiler`.
+     */
+    template <typename T, profiling::profiler Profiler>
+    size_t select_survivors(const objective::basic_matrix<T> &objectives,
+                            const sorting::sorter<T, Profiler::enabled> &fronts,
+                            size_t target_size,
+                            selection_t selection, selection_buffers &buffers,
+                            Profiler &profiler);
+
+    /**
+     * @brief The NSGA-II algorithm.
+     *
+     * @tparam Gen The random number generator, e.g. `rng::xoshiro256ss`,
+     * `rng::pcg64`, `rng::philox4x32` or `std::mt19937`. Each individual of
+     * each generation draws from its own stream `rng::stream<Gen>(seed,
+     * generation, index)`, so a run only depends on `seed`.
+     * @tparam Value The objective value returned by the objective function,
+     * `objective::val_t` or, for integer benchmarks such as mLOTZ,
+     * `objective::compact_val_t`, which is stored without heap allocation and
+     * compared exactly. The values of a population are cached in a
+     * `basic_matrix` of `Value::value_type`.
+     *
+     * The offspring are evaluated in batches, one per chunk of the thread
+     * pool, through an `objective::basic_batch_objective`: a function
+     * returning `Value` is wrapped in an `objective::function_objective`,
+     * called once per genome, while a `batch_evaluator` shared with
+     * `objective::make_batch_objective` costs one virtual call per batch.
+     * If the objective implements `evaluate_delta`, each child is instead
+     * evaluated from the value of its parent and its flipped genes.
+     *
+     * The parents and their offspring are stored as a structure of arrays,
+     * an `individual::basic_population` whose genomes lie in one buffer at a
+     * fixed stride next to their values, ranks and crowding distances. The
+     * criterion iterates the parents in place through a `population_view`.
+     *
+     * The generation loop runs out of arenas allocated by the first
+     * generation. Past that, a generation allocates no memory as long as the
+     * objective and the criterion do not, the sort engine is `deb`,
+     * `bi_objective` or `automatic`, the selection is by crowding distance
+     * and the streams of `Gen` are not seeded from a `std::seed_seq`, which
+     * allocates, as for `std::mt19937`. A wrapped `value_fn_t` allocates the
+     * genome it copies each batch into.
+     *
+     * @tparam Profiler `profiling::none`, which compiles the instrumentation
+     * away, or `profiling::recorder`, which accumulates the time and calls of
+     * each phase of `run`, readable with `profile()`.
+     */
+    template <typename Gen = rng::xoshiro256ss, typename Value = objective::val_t,
+              profiling::profiler Profiler = profiling::none>
     class NSGA2 {
       public:
+        using value_fn_t = objective::basic_fn_t<Value>;
+        using values_t = objective::basic_matrix<typename Value::value_type>;
+        using arena_t = individual::basic_population<typename Value::value_type>;
+        using batch_fn_t =
+            std::shared_ptr<const objective::basic_batch_objective<typename Value::value_type>>;
+
         /**
          * @brief NSGA2 constructor.
          */
         NSGA2(const size_t individual_size, const size_t objective_size,
-              const size_t population_size, const fn_t &f, const double mutation_rate,
+              const size_t population_size, const value_fn_t &f, const double mutation_rate,
               const uint32_t seed);
 
+        /**
+         * @brief NSGA2 constructor with a batch objective of `objective_size`
+         * objectives.
+         */
+        NSGA2(const size_t individual_size, const size_t objective_size,
+              const size_t population_size, batch_fn_t f, const double mutation_rate,
+              const uint32_t seed);
+
+        /**
+         * @brief NSGA2 constructor with a batch objective and mutation rate
+         * set to 1/individual_size.
+         */
+        NSGA2(const size_t individual_size, const size_t objective_size,
+              const size_t population_size, batch_fn_t f,
+              const uint32_t seed = std::random_device()());
+
         /**
          * @brief NSGA2 constructor with mutation rate set to 1/population_size.
          */
         NSGA2(const size_t individual_size, const size_t objective_size,
-              const size_t population_size, const fn_t f,
+              const size_t population_size, const value_fn_t f,
               const uint32_t seed = std::random_device()());
 
         /**
@@ -58,6 +179,29 @@ namespace nsga2 {
          */
         population_t run(criterion_t criterion);
 
+        /**
+         * @brief Select the engine used by `non_dominated_sort`.
+         */
+        void set_sort_strategy(const sorting::strategy strategy);
+
+        /**
+         * @brief Select how the last front is truncated.
+         */
+        void set_selection(const selection_t selection);
+
+        /**
+         * @brief Mutate, evaluate and sort the offspring on `threads` threads.
+         *
+         * @details The objective function must be safe to call concurrently.
+         * The result does not depend on the number of threads.
+         */
+        void set_threads(const size_t threads);
+
+        /**
+         * @brief The statistics recorded by the runs so far.
+         */
+        const Profiler &profile() const { return profiler; }
+
         // Note: A destructor is not necessary since all objects are stack
         // allocated.
 
@@ -66,53 +210,100 @@ namespace nsga2 {
         const size_t population_size;
         const size_t objective_size;
         const double mutation_rate;
-        const fn_t f;
+        const batch_fn_t f;
+        sorting::strategy sort_strategy = sorting::strategy::automatic;
+        selection_t selection = selection_t::crowding_distance;
 
-        population_t population;
+        // The arenas of a generation, allocated once by `init_population`.
+        // The rows [0, N) of `population` hold the parents and the rows
+        // [N, 2N) their children. The survivors are copied with their values,
+        // ranks and crowding distances into the first rows of
+        // `next_population`, which then replaces the current arena, so that
+        // a generation allocates no memory.
+        arena_t population;
+        arena_t next_population;
+
+        // The fronts of the last sort, with their storage, counting the
+        // dominance comparisons only when profiled
+        sorting::sorter<typename Value::value_type, Profiler::enabled> fronts;
+        // Reused by the selection
+        selection_buffers buffers;
 
         /**
-         * @brief init the population uniformly.
+         * @brief init the population uniformly and allocate the arenas.
          *
          * @param individual_size
          * @param population_size
          */
         void init_population(const size_t individual_size, const size_t population_size);
 
-        void mutate(population_t &population);
+        /**
+         * @brief Evaluate the `count` individuals of the population from the
+         * `first`-th in one batch and cache their values.
+         */
+        void evaluate(index_t first, size_t count);
 
-        fronts_t non_dominated_sort(const population_t &population);
+        /**
+         * @brief Fill the rows [N, 2N) of the population with a mutated copy
+         * of each parent and evaluate it.
+         */
+        void mutate();
 
         /**
-         * @brief Calculate the crowding distance for each individual in the front.
-         *
-         * @param population The total population.
-         * @param front the list of indices of the individuals in the front.
-         * @return scores_t
+         * @brief Sort the parents and their offspring into `fronts`.
          */
-        scores_t crowding_distance(const population_t &population, front_t &indices);
+        void non_dominated_sort(const values_t &objectives);
 
         /**
-         * @brief returns the next generation of individuals based on the fronts.
+         * @brief Keep the next generation of individuals based on `fronts`.
          *
-         * @param population
-         * @param fronts
-         * @return population_t
+         * The survivors keep their rank and, for those selected by crowding
+         * distance from the last front, their distance, 0 otherwise. The
+         * population is replaced by swapping the arenas.
          */
-        population_t crowding_distance_select(population_t &population, fronts_t &fronts);
+        void crowding_distance_select();
+
+        // Master seed of the random streams
+        const uint32_t seed;
+        // Current generation, 0 while the population is initialized
+        size_t generation = 0;
+        // Bit-wise mutation with rate `mutation_rate`
+        mutation::bitwise mutation;
+
+        // Runs the offspring loops, inline by default
+        std::unique_ptr<parallel::ThreadPool> pool = std::make_unique<parallel::ThreadPool>(1);
+        // flips[c] is the number of genes flipped in the c-th child
+        std::vector<size_t> flips;
+        // The genes flipped in the current child, per thread of the pool
+        std::vector<std::vector<size_t>> flipped_by_thread;
 
-        // Random number generator
-        std::mt19937 gen;
-        std::bernoulli_distribution dist;
+        // Times the phases of `run`, takes no space with `profiling::none`
+        [[no_unique_address]] Profiler profiler;
 
-        // Random bit generator: Bernoulli(mutation_rate)
         // Count of successful mutations
-        int successful_mutations = 0;
+        size_t successful_mutations = 0;
         // Total number of mutation attempts
-        int mutation_attempts = 0;
-
-        uint8_t generate_mutation_bit();
+        size_t mutation_attempts = 0;
 
         // for sanity check
         double mutation_ratio();
     };
+
+    // Instantiated in nsga2.cpp
+    extern template class NSGA2<rng::xoshiro256ss>;
+    extern template class NSGA2<rng::pcg64>;
+    extern template class NSGA2<rng::philox4x32>;
+    extern template class NSGA2<std::mt19937>;
+    extern template class NSGA2<rng::xoshiro256ss, objective::compact_val_t>;
+    extern template class NSGA2<rng::pcg64, objective::compact_val_t>;
+    extern template class NSGA2<rng::philox4x32, objective::compact_val_t>;
+    extern template class NSGA2<std::mt19937, objective::compact_val_t>;
+    extern template class NSGA2<rng::xoshiro256ss, objective::val_t, profiling::recorder>;
+    extern template class NSGA2<rng::pcg64, objective::val_t, profiling::recorder>;
+    extern template class NSGA2<rng::philox4x32, objective::val_t, profiling::recorder>;
+    extern template class NSGA2<std::mt19937, objective::val_t, profiling::recorder>;
+    extern template class NSGA2<rng::xoshiro256ss, objective::compact_val_t, profiling::recorder>;
+    extern template class NSGA2<rng::pcg64, objective::compact_val_t, profiling::recorder>;
+    extern template class NSGA2<rng::philox4x32, objective::compact_val_t, profiling::recorder>;
+    extern template class NSGA2<std::mt19937, objective::compact_val_t, profiling::recorder>;
 } // namespace nsga2
\ No newline at end of file
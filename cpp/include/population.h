@@ -0,0 +1,110 @@
+#pragma once
+
+#include "individual.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace individual {
+
+    /**
+     * @brief A population stored as a structure of arrays.
+     *
+     * @details The genomes of the `size()` individuals lie in one row-major
+     * buffer, `stride()` words apart, next to parallel arrays holding their
+     * objective values, ranks and crowding distances. Copying an individual
+     * copies a few words per array, and scanning the population reads
+     * contiguous memory instead of one heap block per genome. `view()`
+     * exposes the genomes as a range of `genome_view`, which end criteria
+     * iterate without copying.
+     *
+     * @tparam T The type of a single objective, as in `objective::basic_matrix`.
+     */
+    template <typename T>
+    class basic_population {
+        std::vector<word_t> words_;
+        objective::basic_matrix<T> objectives_;
+        std::vector<size_t> ranks_;
+        std::vector<double> distances_;
+        size_t size_ = 0;
+        size_t genes_ = 0;
+        size_t stride_ = 0;
+
+      public:
+        basic_population() = default;
+
+        /* `size` individuals of `genes` genes set to zero, with `objectives` values each. */
+        basic_population(size_t size, size_t genes, size_t objectives)
+            : words_(size * words_for(genes), 0), objectives_(size, objectives), ranks_(size, 0),
+              distances_(size, 0.0), size_(size), genes_(genes), stride_(words_for(genes)) {}
+
+        /* A copy of the genomes of `population`, with `objectives` values each. */
+        basic_population(const population_t &population, size_t objectives)
+            : basic_population(population.size(),
+                               population.empty() ? 0 : population[0].size(), objectives) {
+            for (size_t i = 0; i < size_; i++) {
+                assert(population[i].size() == genes_);
+                std::ranges::copy(population[i].words(), row(i).words().begin());
+            }
+        }
+
+        /* The number of individuals. */
+        size_t size() const { return size_; }
+
+        /* The number of genes of an individual. */
+        size_t genes() const { return genes_; }
+
+        /* The number of words from a genome to the next. */
+        size_t stride() const { return stride_; }
+
+        /* The genome of the `i`-th individual. */
+        genome_view operator[](size_t i) const {
+            return genome_view(words_.data() + i * stride_, 0, genes_);
+        }
+        genome_ref row(size_t i) { return genome_ref(words_.data() + i * stride_, genes_); }
+
+        /* The objective values, row `i` being those of the `i`-th individual. */
+        const objective::basic_matrix<T> &objectives() const { return objectives_; }
+        objective::basic_matrix<T> &objectives() { return objectives_; }
+
+        /* The rank of each individual, 0 for the first front. */
+        std::span<const size_t> ranks() const { return ranks_; }
+        std::span<size_t> ranks() { return ranks_; }
+
+        /* The crowding distance of each individual. */
+        std::span<const double> distances() const { return distances_; }
+        std::span<double> distances() { return distances_; }
+
+        /* The genomes of all the individuals. */
+        population_view view() const {
+            return population_view(words_.data(), size_, genes_, stride_);
+        }
+        operator population_view() const { return view(); }
+
+        /* Copies the `j`-th individual of `from`, with its values, rank and
+           distance, to the `i`-th individual. */
+        void assign(size_t i, const basic_population &from, size_t j) {
+            assert(from.genes_ == genes_ && from.objectives_.cols() == objectives_.cols());
+            const word_t *source = from.words_.data() + j * stride_;
+            std::copy(source, source + stride_, words_.begin() + i * stride_);
+            objectives_.assign(i, from.objectives_[j]);
+            ranks_[i] = from.ranks_[j];
+            distances_[i] = from.distances_[j];
+        }
+
+        /* A copy of the first `count` genomes as runtime-sized individuals. */
+        population_t to_population(size_t count) const {
+            assert(count <= size_);
+            population_t out(count, individual_t(genes_));
+            for (size_t i = 0; i < count; i++) {
+                const word_t *source = words_.data() + i * stride_;
+                std::copy(source, source + stride_, out[i].words().begin());
+            }
+            return out;
+        }
+        population_t to_population() const { return to_population(size_); }
+    };
+
+} // namespace individual
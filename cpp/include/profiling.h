@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+/**
+ * @namespace profiling
+ * @brief Per-phase instrumentation of the generation loop.
+ *
+ * @details `nsga2::NSGA2` takes a profiler as its last template parameter.
+ * The default, `profiling::none`, is an empty type whose probes are empty
+ * inline functions, so a run without profiling compiles to the same code as
+ * an uninstrumented one. `profiling::recorder` accumulates the wall time and
+ * the number of calls of each phase, along with statistics of the sorts.
+ */
+namespace profiling {
+    using clock = std::chrono::steady_clock;
+
+    /* The instrumented phases of a generation. */
+    enum class phase {
+        mutate,             // mutation of the offspring, evaluation included
+        evaluate,           // calls to the objective, summed over the threads
+        non_dominated_sort, // sort of the parents and offspring into fronts
+        crowding_distance,  // crowding distances of the last front
+        select,             // selection of the next population, crowding distance included
+    };
+
+    constexpr size_t phases = 5;
+
+    /* The name of a phase, as written to the JSON output. */
+    std::string to_string(phase p);
+
+    /* A type which can profile the generation loop. */
+    template <typename P>
+    concept profiler = requires { requires std::same_as<decltype(P::enabled), const bool>; };
+
+    /* No profiling. */
+    struct none {
+        static constexpr bool enabled = false;
+
+        void add(phase, clock::duration) {}
+        void add_sort(std::optional<size_t>, size_t) {}
+        void add_last_front(size_t) {}
+    };
+
+    static_assert(std::is_empty_v<none>, "profiling::none must take no space");
+
+    /**
+     * @brief Accumulates the time and calls of each phase.
+     *
+     * @details `add` may be called concurrently, e.g. by the threads
+     * evaluating the offspring.
+     */
+    class recorder {
+      public:
+        static constexpr bool enabled = true;
+
+        /* Adds one call of `p` which lasted `elapsed`. */
+        void add(phase p, clock::duration elapsed) {
+            ticks[size_t(p)].fetch_add(elapsed.count(), std::memory_order_relaxed);
+            calls_[size_t(p)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /* Adds the statistics of a sort into `fronts` fronts. */
+        void add_sort(std::optional<size_t> comparisons, size_t fronts);
+
+        /* Adds the size of the front split by a selection, 0 if none was. */
+        void add_last_front(size_t size);
+
+        /* The total wall time of `p`, in seconds. */
+        double seconds(phase p) const;
+
+        /* The number of calls of `p`. */
+        size_t calls(phase p) const { return calls_[size_t(p)].load(std::memory_order_relaxed); }
+
+        /* The number of dominance comparisons, if every sort counted them. */
+        std::optional<size_t> comparisons() const;
+
+        /* The number of fronts of the last sort. */
+        size_t fronts() const { return last_fronts; }
+
+        /* The size of the front split by the last selection. */
+        size_t last_front() const { return last_front_size; }
+
+        /* The totals, phase by phase, and the statistics of the sorts. */
+        nlohmann::json to_json() const;
+
+        /* Writes `to_json()` to `filename`. */
+        void save(const std::string &filename) const;
+
+      private:
+        std::array<std::atomic<clock::rep>, phases> ticks{};
+        std::array<std::atomic<size_t>, phases> calls_{};
+        size_t sorts = 0;
+        size_t counted_sorts = 0;
+        size_t comparisons_ = 0;
+        size_t total_fronts = 0;
+        size_t last_fronts = 0;
+        size_t selections = 0;
+        size_t total_last_front = 0;
+        size_t last_front_size = 0;
+    };
+
+    /**
+     * @brief Adds the time from its construction to its destruction to the
+     * phase `p` of a profiler.
+     */
+    template <profiler P>
+    class timer {
+        P &target;
+        phase p;
+        clock::time_point start = clock::now();
+
+      public:
+        timer(P &target, phase p) : target(target), p(p) {}
+        timer(const timer &) = delete;
+        ~timer() { target.add(p, clock::now() - start); }
+    };
+
+    /* Times nothing, and does not read the clock. */
+    template <>
+    class timer<none> {
+      public:
+        timer(none &, phase) {}
+        timer(const timer &) = delete;
+    };
+
+    static_assert(std::is_empty_v<timer<none>>, "an unused timer must take no space");
+} // namespace profiling
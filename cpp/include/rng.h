@@ -0,0 +1,274 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <type_traits>
+
+/**
+ * @namespace rng
+ * @brief Fast pseudo-random number generators.
+ *
+ * @details Every generator satisfies `std::uniform_random_bit_generator` and
+ * can be used with the distributions of `<random>`, or as the generator of
+ * `nsga2::NSGA2`. They also provide a bulk `fill` of 64-bit words, which
+ * `rng::fill` falls back to emulating for the standard generators.
+ */
+namespace rng {
+
+    /**
+     * @brief SplitMix64 (Steele, Lea and Flood 2014).
+     *
+     * @details A tiny generator whose outputs are well mixed even for
+     * consecutive seeds. It is used to seed the other generators.
+     */
+    class splitmix64 {
+        uint64_t state;
+
+      public:
+        using result_type = uint64_t;
+
+        explicit splitmix64(uint64_t seed = 0) : state(seed) {}
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            uint64_t z = (state += 0x9e3779b97f4a7c15);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            return z ^ (z >> 31);
+        }
+    };
+
+    /**
+     * @brief xoshiro256** (Blackman and Vigna 2018).
+     *
+     * @details 32 bytes of state, period 2^256 - 1, and a handful of
+     * instructions per 64-bit output.
+     */
+    class xoshiro256ss {
+        std::array<uint64_t, 4> s;
+
+        static uint64_t next(uint64_t &s0, uint64_t &s1, uint64_t &s2, uint64_t &s3) {
+            const uint64_t result = std::rotl(s1 * 5, 7) * 9;
+            const uint64_t t = s1 << 17;
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3 = std::rotl(s3, 45);
+            return result;
+        }
+
+      public:
+        using result_type = uint64_t;
+
+        /* Seeds the state with SplitMix64, as recommended by the authors. */
+        explicit xoshiro256ss(uint64_t seed = 0) {
+            splitmix64 mix(seed);
+            for (uint64_t &word : s)
+                word = mix();
+        }
+
+        /* Sets the state directly. It must not be all zeros. */
+        explicit xoshiro256ss(const std::array<uint64_t, 4> &state) : s(state) {}
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() { return next(s[0], s[1], s[2], s[3]); }
+
+        /* Fills `words` with random words, keeping the state in registers. */
+        void fill(std::span<uint64_t> words) {
+            uint64_t s0 = s[0], s1 = s[1], s2 = s[2], s3 = s[3];
+            for (uint64_t &word : words)
+                word = next(s0, s1, s2, s3);
+            s = {s0, s1, s2, s3};
+        }
+    };
+
+    /**
+     * @brief PCG64, i.e. PCG XSL RR 128/64 (O'Neill 2014).
+     *
+     * @details A 128-bit linear congruential generator with a permuted output.
+     * Each odd increment selects an independent stream. Seeding matches the
+     * reference `pcg64_srandom_r(seed, stream)`.
+     */
+    class pcg64 {
+        using state_t = unsigned __int128;
+
+        static constexpr state_t multiplier =
+            (state_t(0x2360ed051fc65da4) << 64) | state_t(0x4385df649fccf645);
+        static constexpr state_t default_stream =
+            (state_t(0x5851f42d4c957f2d) << 64) | state_t(0x14057b7ef767814f);
+
+        state_t state;
+        state_t increment;
+
+        static uint64_t output(state_t s) {
+            return std::rotr(uint64_t(s >> 64) ^ uint64_t(s), int(s >> 122));
+        }
+
+      public:
+        using result_type = uint64_t;
+
+        explicit pcg64(uint64_t seed = 0) : pcg64(seed, default_stream >> 1) {}
+
+        pcg64(state_t seed, state_t stream) : state(0), increment((stream << 1) | 1) {
+            (*this)();
+            state += seed;
+            (*this)();
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            state = state * multiplier + increment;
+            return output(state);
+        }
+
+        /* Fills `words` with random words, keeping the state in registers. */
+        void fill(std::span<uint64_t> words) {
+            state_t s = state;
+            for (uint64_t &word : words) {
+                s = s * multiplier + increment;
+                word = output(s);
+            }
+            state = s;
+        }
+    };
+
+    /**
+     * @brief Philox4x32-10 (Salmon et al. 2011), a counter-based generator.
+     *
+     * @details Each 128-bit output block is a bijection of a 128-bit counter
+     * under a 64-bit key, so any block of any stream can be computed directly,
+     * without running the generator up to it. The key is the seed, the
+     * two high words of the counter select the stream, and the two low
+     * words count the blocks inside the stream.
+     */
+    class philox4x32 {
+        std::array<uint32_t, 2> key;
+        std::array<uint32_t, 4> counter;
+        std::array<uint64_t, 2> block;
+        size_t used = 2;
+
+        static constexpr uint32_t m0 = 0xd2511f53, m1 = 0xcd9e8d57;
+        static constexpr uint32_t w0 = 0x9e3779b9, w1 = 0xbb67ae85;
+
+        void next_block() {
+            std::array<uint32_t, 4> out = generate(counter, key);
+            block = {(uint64_t(out[1]) << 32) | out[0], (uint64_t(out[3]) << 32) | out[2]};
+            used = 0;
+            // Increment the 64-bit block counter
+            if (++counter[0] == 0)
+                ++counter[1];
+        }
+
+      public:
+        using result_type = uint64_t;
+
+        /* The block of the counter `ctr` under the key `k`. */
+        static std::array<uint32_t, 4> generate(std::array<uint32_t, 4> ctr,
+                                                std::array<uint32_t, 2> k) {
+            for (int round = 0; round < 10; round++) {
+                if (round > 0) {
+                    k[0] += w0;
+                    k[1] += w1;
+                }
+                uint64_t p0 = uint64_t(m0) * ctr[0];
+                uint64_t p1 = uint64_t(m1) * ctr[2];
+                ctr = {uint32_t(p1 >> 32) ^ ctr[1] ^ k[0], uint32_t(p1),
+                       uint32_t(p0 >> 32) ^ ctr[3] ^ k[1], uint32_t(p0)};
+            }
+            return ctr;
+        }
+
+        /* The stream `(stream_hi, stream_lo)` of the key `seed`. */
+        explicit philox4x32(uint64_t seed = 0, uint32_t stream_hi = 0, uint32_t stream_lo = 0)
+            : key{uint32_t(seed), uint32_t(seed >> 32)}, counter{0, 0, stream_lo, stream_hi},
+              block{} {}
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            if (used == 2)
+                next_block();
+            return block[used++];
+        }
+
+        /* Fills `words` with random words, two per block. */
+        void fill(std::span<uint64_t> words) {
+            for (uint64_t &word : words)
+                word = (*this)();
+        }
+    };
+
+    /* A 64-bit seed for the stream `(generation, index)` of a master seed. */
+    inline uint64_t stream_seed(uint64_t seed, uint64_t generation, uint64_t index) {
+        uint64_t h = splitmix64(seed)();
+        h = splitmix64(h ^ generation)();
+        return splitmix64(h ^ index)();
+    }
+
+    /**
+     * @brief An independent generator for each `(seed, generation, index)`.
+     *
+     * @details Streams let every individual draw its own random numbers, so a
+     * run gives the same result whatever the order or the thread in which
+     * individuals are processed. Philox and PCG64 select a stream natively;
+     * other generators are seeded from a hash of the tuple.
+     */
+    template <typename Gen>
+    Gen stream(uint64_t seed, uint64_t generation, uint64_t index) {
+        if constexpr (std::is_same_v<Gen, philox4x32>) {
+            return philox4x32(seed, uint32_t(generation), uint32_t(index));
+        } else if constexpr (std::is_same_v<Gen, pcg64>) {
+            // Distinct states as well: streams sharing a state are correlated
+            return pcg64(stream_seed(seed, generation, index),
+                         (static_cast<unsigned __int128>(generation) << 64) | index);
+        } else if constexpr (std::is_constructible_v<Gen, std::seed_seq &>) {
+            // e.g. std::mt19937, whose 32-bit seeds would collide
+            uint64_t h = stream_seed(seed, generation, index);
+            std::seed_seq seq{uint32_t(h), uint32_t(h >> 32), uint32_t(index),
+                              uint32_t(generation)};
+            return Gen(seq);
+        } else {
+            return Gen(stream_seed(seed, generation, index));
+        }
+    }
+
+    /**
+     * @brief Fills `words` with uniformly random 64-bit words.
+     *
+     * @details Uses the bulk `fill` of the generator when there is one, and
+     * otherwise combines its outputs, e.g. two draws of a 32-bit
+     * `std::mt19937` per word.
+     */
+    template <typename Gen>
+    void fill(Gen &gen, std::span<uint64_t> words) {
+        using result_type = typename Gen::result_type;
+        if constexpr (requires { gen.fill(words); }) {
+            gen.fill(words);
+        } else if constexpr (Gen::min() == 0 &&
+                             Gen::max() == std::numeric_limits<uint64_t>::max()) {
+            for (uint64_t &word : words)
+                word = gen();
+        } else {
+            static_assert(Gen::min() == 0 && Gen::max() == std::numeric_limits<uint32_t>::max(),
+                          "rng::fill needs a generator of 32-bit or 64-bit words");
+            for (uint64_t &word : words) {
+                uint64_t high = static_cast<result_type>(gen());
+                word = (high << 32) | static_cast<result_type>(gen());
+            }
+        }
+    }
+} // namespace rng
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "dominance.h"
+#include "individual.h"
+#include "thread_pool.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace sorting
+ * @brief Non-dominated sorting engines.
+ *
+ * @details Every engine takes the cached objective values of a population and
+ * returns its fronts: the first front holds the indices of the non-dominated
+ * rows, the second front the rows only dominated by the first front, etc.
+ * All engines return the same fronts, although the order of the indices
+ * inside a front may differ. They are instantiated for `double`, `int32_t`
+ * and `uint16_t` objectives.
+ */
+namespace sorting {
+    using matrix_t = objective::matrix_t;
+    template <typename T>
+    using basic_matrix = objective::basic_matrix<T>;
+
+    using index_t = std::size_t;           // index of an individual in a population
+    using front_t = std::vector<index_t>;  // front of the same rank
+    using fronts_t = std::vector<front_t>; // list of fronts
+
+    /* The available non-dominated sorting engines. */
+    enum class strategy {
+        automatic,      // bi_objective when there are two objectives, deb otherwise
+        graph,          // dominance graph in adjacency lists, O(mN^2) with hashing
+        deb,            // Deb's fast non-dominated sort on a dominance bit matrix, O(mN^2)
+        ens_ss,         // efficient non-dominated sort with sequential search, O(mN^2) worst case
+        ens_bs,         // efficient non-dominated sort with binary search, O(mN^2) worst case
+        bi_objective,   // sort and sweep for exactly two objectives, O(NlogN)
+        divide_conquer, // Jensen-Fortin divide and conquer, O(N log^(m-1) N)
+    };
+
+    /* Parses the name of a strategy, as given on the command line. */
+    strategy parse_strategy(const std::string &name);
+
+    /* The name of a strategy. */
+    std::string to_string(strategy s);
+
+    /**
+     * @brief Sort by building the dominance graph in a `Graph` and peeling it
+     * front by front.
+     */
+    template <typename T>
+    fronts_t graph_sort(const basic_matrix<T> &objectives);
+
+    /**
+     * @brief Deb's fast non-dominated sort.
+     *
+     * @details Each row is compared to all rows at once by
+     * `pareto::dominates_many`, which yields its row of an N x N bit matrix
+     * of dominated sets and its domination count, so no hashing nor per-edge
+     * allocation is needed. Fronts are then peeled by scanning the set bits
+     * of the current front's rows. Each front is in increasing order of
+     * indices.
+     */
+    template <typename T>
+    fronts_t deb_sort(const basic_matrix<T> &objectives);
+
+    /**
+     * @brief Deb's fast non-dominated sort on the threads of `pool`.
+     *
+     * @details Each thread fills whole rows of the bit matrix: the row `i`
+     * and the domination count of `i` are written by the thread comparing
+     * `i` to every other row, so no write is shared. The fronts are then
+     * peeled with the columns of the matrix split across the threads. The
+     * fronts are the same as the ones of the serial sort, in the same order.
+     */
+    template <typename T>
+    fronts_t deb_sort(const basic_matrix<T> &objectives, parallel::ThreadPool &pool);
+
+    /**
+     * @brief Efficient non-dominated sort (ENS, Zhang et al. 2015).
+     *
+     * @details Rows are visited in decreasing lexicographic order, so that a
+     * row can only be dominated by rows visited before it. Each row is then
+     * inserted into the first front containing no row that dominates it. With
+     * few fronts, as in a converged population, most pairs are never compared.
+     *
+     * @param binary_search Search the front of each row by binary search
+     * (ENS-BS) instead of sequentially from the first front (ENS-SS).
+     */
+    template <typename T>
+    fronts_t ens_sort(const basic_matrix<T> &objectives, bool binary_search);
+
+    /**
+     * @brief Non-dominated sort for exactly two objectives.
+     *
+     * @details Rows are visited in decreasing lexicographic order. The last
+     * row added to a front has the largest second objective of that front, so
+     * whether the front dominates the next row is decided by this tail alone,
+     * and the front of each row is found by binary search over the tails.
+     */
+    template <typename T>
+    fronts_t bi_objective_sort(const basic_matrix<T> &objectives);
+
+    /**
+     * @brief Divide-and-conquer non-dominated sort (Jensen 2003, generalized
+     * to ties by Fortin et al. 2013).
+     *
+     * @details Identical rows are merged first, since they share their rank.
+     * The remaining rows are split by the median of the last objective,
+     * each half is ranked recursively, and the ranks of the upper half are
+     * then updated from the lower half on the remaining objectives. Two
+     * objectives are handled by a sweep over a staircase of ranks.
+     */
+    template <typename T>
+    fronts_t divide_conquer_sort(const basic_matrix<T> &objectives);
+
+    /* Groups the rows into fronts given the rank of each row, starting from 0. */
+    fronts_t fronts_from_ranks(const std::vector<size_t> &ranks);
+
+    /* Sort with the given engine, on the threads of `pool` if the engine supports it. */
+    template <typename T>
+    fronts_t sort(const basic_matrix<T> &objectives, strategy s,
+                  parallel::ThreadPool *pool = nullptr);
+
+    /**
+     * @brief A non-dominated sort which keeps its storage from one call to
+     * the next.
+     *
+     * @details The fronts are stored back to back in one array, along with
+     * the rank of each row, and are the same as the ones of `sort`, in the
+     * same order. Once its buffers have grown to the size of the population,
+     * sorting with the `deb`, `bi_objective` or `automatic` engines
+     * allocates no memory; the other engines sort into a `fronts_t` which is
+     * then copied.
+     *
+     * @tparam Counting Whether the sorts count their dominance comparisons,
+     * readable with `comparisons()`. Off by default, so that a sort which is
+     * not profiled does none of this work.
+     */
+    template <typename T, bool Counting = false>
+    class sorter {
+      public:
+        /* Sort `objectives`, replacing the previous fronts. */
+        void sort(const basic_matrix<T> &objectives, strategy s,
+                  parallel::ThreadPool *pool = nullptr);
+
+        /* The number of fronts. */
+        size_t size() const { return offsets.size() - 1; }
+
+        /* The `k`-th front. */
+        std::span<const index_t> operator[](size_t k) const {
+            return std::span<const index_t>(order).subspan(offsets[k], offsets[k + 1] - offsets[k]);
+        }
+
+        /* The rank of the row `i`, i.e. the index of its front. */
+        size_t rank(index_t i) const { return ranks[i]; }
+
+        /* A copy of the fronts. */
+        fronts_t fronts() const;
+
+        /* The number of dominance comparisons made by the last sort, counting
+           each row compared to each row for `deb` and each tail probed for
+           `bi_objective`, or none for the engines which do not count them. */
+        std::optional<size_t> comparisons() const
+            requires Counting
+        {
+            return comparisons_;
+        }
+
+      private:
+        // The front k is order[offsets[k] .. offsets[k + 1])
+        std::vector<index_t> order;
+        std::vector<size_t> offsets{0};
+        std::vector<size_t> ranks;
+
+        // Deb's sort: the dominance bit matrix, the domination counts, the
+        // scratch of `pareto::dominates_many`, the rows peeled by the
+        // threaded sort and the columns of the values
+        std::vector<individual::word_t> dominated;
+        std::vector<size_t> count;
+        std::vector<individual::word_t> worse;
+        std::vector<individual::word_t> ready;
+        pareto::column_block<T> block;
+        // Bi-objective sort: the rows in decreasing lexicographic order and
+        // the last row added to each front
+        std::vector<index_t> visit;
+        std::vector<index_t> tails;
+        // Only set when `Counting`
+        std::optional<size_t> comparisons_;
+
+        void clear(size_t size);
+        void close_front();
+        void deb(const basic_matrix<T> &objectives, parallel::ThreadPool *pool);
+        void bi_objective(const basic_matrix<T> &objectives);
+        void assign(const fronts_t &fronts);
+    };
+
+    // Instantiated in sorting.cpp
+    extern template class sorter<double, false>;
+    extern template class sorter<int32_t, false>;
+    extern template class sorter<uint16_t, false>;
+    extern template class sorter<double, true>;
+    extern template class sorter<int32_t, true>;
+    extern template class sorter<uint16_t, true>;
+} // namespace sorting
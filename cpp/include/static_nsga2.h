@@ -0,0 +1,189 @@
+#pragma once
+
+#include "individual.h"
+#include "mutation.h"
+#include "nsga2.h"
+#include "profiling.h"
+#include "rng.h"
+#include "sorting.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <print>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace nsga2 {
+
+    /**
+     * @brief The NSGA-II algorithm for a genome size `N_BITS` and a number of
+     * objectives `M_OBJ` fixed at compile time.
+     *
+     * @details Genomes are `individual::static_genome<N_BITS>` and the
+     * objective function `F` is called directly, without `std::function`,
+     * returning a `std::array` of `M_OBJ` values. Evaluation thus allocates
+     * nothing and the loops over genes, words and objectives have constant
+     * trip counts. Sorting, mutation, random streams and threads are those of
+     * `NSGA2`, which remains the path for any other configuration: for the
+     * same seed and settings, both give the same populations.
+     *
+     * Like `NSGA2`, the generation loop runs out of buffers allocated by the
+     * first generation: the parents and their offspring are double-buffered
+     * and the survivors are copied into the spare buffers, which are then
+     * swapped in.
+     *
+     * @tparam F A callable `std::array<T, M_OBJ>(const static_genome<N_BITS> &)`
+     * where `T` is `double`, `int32_t` or `uint16_t`.
+     */
+    template <size_t N_BITS, size_t M_OBJ, typename F, typename Gen = rng::xoshiro256ss>
+    class StaticNSGA2 {
+      public:
+        using genome_t = individual::static_genome<N_BITS>;
+        using value_t = std::invoke_result_t<const F &, const genome_t &>;
+        using objective_t = typename value_t::value_type;
+        using values_t = objective::basic_matrix<objective_t>;
+
+        static_assert(std::is_same_v<value_t, std::array<objective_t, M_OBJ>>,
+                      "the objective function must return a std::array of M_OBJ values");
+
+        StaticNSGA2(const size_t population_size, const F f, const double mutation_rate,
+                    const uint32_t seed)
+            : population_size(population_size), mutation_rate(mutation_rate), f(f), seed(seed),
+              mutation(mutation_rate) {}
+
+        /* Mutation rate set to 1/N_BITS. */
+        StaticNSGA2(const size_t population_size, const F f,
+                    const uint32_t seed = std::random_device()())
+            : StaticNSGA2(population_size, f, 1.0 / N_BITS, seed) {}
+
+        /**
+         * @brief Run the NSGA-II algorithm, as `NSGA2::run`.
+         *
+         * @details The criterion sees the genomes in place, as the words of
+         * the vector of static genomes are contiguous.
+         */
+        population_t run(criterion_t criterion) {
+            std::println("Running NSGA2 with a static genome of {0} genes and {1} objectives",
+                         N_BITS, M_OBJ);
+            std::println("Population Size: {0}", population_size);
+            std::println("Mutation Rate: {0}", mutation_rate);
+
+            init_population();
+            size_t iter = 0;
+            while (!criterion(view(), iter)) {
+                generation = iter + 1;
+                mutate();
+                fronts.sort(objectives, sort_strategy, pool.get());
+                select();
+                iter++;
+            }
+            return runtime_population();
+        }
+
+        /* Select the engine used to sort the fronts. */
+        void set_sort_strategy(const sorting::strategy strategy) { sort_strategy = strategy; }
+
+        /* Select how the last front is truncated. */
+        void set_selection(const selection_t selection) { this->selection = selection; }
+
+        /* Mutate, evaluate and sort the offspring on `threads` threads. */
+        void set_threads(const size_t threads) {
+            pool = std::make_unique<parallel::ThreadPool>(threads);
+        }
+
+      private:
+        const size_t population_size;
+        const double mutation_rate;
+        const F f;
+        const uint32_t seed;
+        size_t generation = 0;
+        sorting::strategy sort_strategy = sorting::strategy::automatic;
+        selection_t selection = selection_t::crowding_distance;
+        mutation::bitwise mutation;
+        std::unique_ptr<parallel::ThreadPool> pool = std::make_unique<parallel::ThreadPool>(1);
+
+        // The rows [0, N) hold the parents and the rows [N, 2N) their
+        // children, objectives[i] caches the value of population[i]. The
+        // survivors are copied into the first rows of `next_population` and
+        // `next_objectives`, which are then swapped in.
+        std::vector<genome_t> population;
+        std::vector<genome_t> next_population;
+        values_t objectives;
+        values_t next_objectives;
+
+        // The fronts of the last sort, with their storage
+        sorting::sorter<objective_t> fronts;
+        // Reused by the selection
+        selection_buffers buffers;
+        // The selection records nothing
+        [[no_unique_address]] profiling::none profiler;
+
+        void evaluate(index_t i) { objectives.assign(i, f(population[i])); }
+
+        void init_population() {
+            population.assign(2 * population_size, genome_t());
+            next_population.assign(2 * population_size, genome_t());
+            objectives = values_t(2 * population_size, M_OBJ);
+            next_objectives = values_t(2 * population_size, M_OBJ);
+            buffers.reserve(population_size, M_OBJ);
+            generation = 0;
+            pool->parallel_for(population_size, [&](size_t begin, size_t end) {
+                for (index_t i = begin; i < end; i++) {
+                    // Uniform genes, 64 per random word of the stream (0, i)
+                    Gen gen = rng::stream<Gen>(seed, generation, i);
+                    rng::fill(gen, population[i].words());
+                    population[i].trim();
+                    evaluate(i);
+                }
+            });
+        }
+
+        void mutate() {
+            pool->parallel_for(population_size, [&](size_t begin, size_t end) {
+                // A private copy, the distributions of the operator are not shared
+                mutation::bitwise bitwise = mutation;
+                for (size_t c = begin; c < end; c++) {
+                    // The child of the parent c draws from the stream (generation, c)
+                    Gen gen = rng::stream<Gen>(seed, generation, c);
+                    index_t i = population_size + c;
+                    population[i] = population[c];
+                    bitwise(population[i], gen);
+                    evaluate(i);
+                }
+            });
+        }
+
+        /* Keep the next generation, as `NSGA2::crowding_distance_select`. */
+        void select() {
+            select_survivors(objectives, fronts, population_size, selection, buffers, profiler);
+            const front_t &selected = buffers.selected;
+            for (size_t i = 0; i < population_size; i++) {
+                next_population[i] = population[selected[i]];
+                std::ranges::copy(objectives[selected[i]], next_objectives.row(i).begin());
+            }
+            std::swap(population, next_population);
+            std::swap(objectives, next_objectives);
+        }
+
+        // The genomes of the population, one after the other
+        individual::population_view view() const {
+            constexpr size_t stride = individual::words_for(N_BITS);
+            static_assert(sizeof(genome_t) == stride * sizeof(individual::word_t));
+            return individual::population_view(population.data()->words().data(),
+                                               population_size, N_BITS, stride);
+        }
+
+        population_t runtime_population() const {
+            population_t out(population_size, individual_t(N_BITS));
+            for (size_t i = 0; i < population_size; i++)
+                std::ranges::copy(population[i].words(), out[i].words().begin());
+            return out;
+        }
+    };
+
+} // namespace nsga2
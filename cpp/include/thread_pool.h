@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @namespace parallel
+ * @brief A fixed pool of worker threads for data-parallel loops.
+ */
+namespace parallel {
+
+    /**
+     * @brief A pool of `threads - 1` workers which, together with the calling
+     * thread, run the chunks of a `parallel_for`.
+     *
+     * @details The workers sleep between two loops, so a loop costs two
+     * wake-ups rather than thread creations. A pool of one thread runs every
+     * loop inline on the caller.
+     */
+    class ThreadPool {
+      public:
+        /**
+         * @brief A non-owning reference to a callable `void(size_t begin,
+         * size_t end)`, which unlike `std::function` never allocates.
+         */
+        class task_t {
+            void *object;
+            void (*call)(void *object, size_t begin, size_t end);
+
+          public:
+            template <typename F>
+                requires(!std::is_same_v<std::remove_cvref_t<F>, task_t>)
+            task_t(F &&f)
+                : object(const_cast<void *>(static_cast<const void *>(std::addressof(f)))),
+                  call([](void *object, size_t begin, size_t end) {
+                      (*static_cast<std::remove_reference_t<F> *>(object))(begin, end);
+                  }) {}
+
+            void operator()(size_t begin, size_t end) const { call(object, begin, end); }
+        };
+
+        explicit ThreadPool(size_t threads = 1);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /* Number of threads running a loop, the caller included. */
+        size_t size() const { return workers.size() + 1; }
+
+        /* The index of the calling thread in its pool, from 1 for the
+           workers, and 0 for any other thread, e.g. the caller of a loop. */
+        static size_t index();
+
+        /**
+         * @brief Call `task(begin, end)` on disjoint chunks covering `[0, n)`
+         * and return when all of them are done.
+         *
+         * @details Chunks are claimed dynamically, a few per thread, so that
+         * uneven chunks balance out. `task` must be safe to call concurrently.
+         * Loops are not reentrant: `task` must not call `parallel_for`.
+         * Neither the pool nor the loop allocate memory.
+         */
+        void parallel_for(size_t n, task_t task);
+
+      private:
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wake; // a loop started, or the pool stops
+        std::condition_variable done; // every worker left the loop
+
+        // The current loop, valid while `busy > 0`
+        const task_t *task = nullptr;
+        size_t n = 0;
+        size_t chunk = 0;
+        std::atomic<size_t> next{0};
+        size_t epoch = 0; // incremented at each loop
+        size_t busy = 0;  // workers still in the loop
+        bool stopping = false;
+
+        void work(size_t index);
+        void run_chunks();
+    };
+
+} // namespace parallel
@@ -14,13 +14,17 @@
 namespace end_criteria {
     using individual_t = individual::individual_t;
     using population_t = individual::population_t;
+    using population_view = individual::population_view;
 
     /**
      * @typedef criterion_t
      * @brief Alias for a callable that determines whether the algorithm
      * should terminate.
+     *
+     * @details It sees the genomes of the current population in place, as a
+     * range of `individual::genome_view`.
      */
-    using criterion_t = std::function<bool(const population_t &, const size_t)>;
+    using criterion_t = std::function<bool(const population_view &, const size_t)>;
 
     /**
      * @brief A functor to determine if the maximum number of iterations has
@@ -32,7 +36,7 @@ namespace end_criteria {
     struct max_iterations {
         const size_t max_iters;
         max_iterations(const size_t max_iterations);
-        bool operator()(const population_t &population, const size_t iteration);
+        bool operator()(const population_view &population, const size_t iteration);
     };
 
     /**
@@ -44,22 +48,32 @@ namespace end_criteria {
     struct cover_mlotz_pareto_front {
         size_t m;
         cover_mlotz_pareto_front(const size_t m);
-        bool operator()(const population_t &population, const size_t iteration);
+        bool operator()(const population_view &population, const size_t iteration);
     };
 
     /**
      * @struct Task6Logger
      * @brief This struct is used to count the number of individuals reaching
-     * the Pareto front in each iteration and record a JSON log. It
+     * the Pareto front in each iteration and record a log. It
      * automatically stops after reaching the maximum number of iterations.
      *
+     * @details The log is newline-delimited JSON, one compact record per line
+     * with a `type` field: a `metadata` record written when the logger is
+     * built, one `generation` record per iteration and a `final_population`
+     * record at the end. The file is only appended to. Generation records are
+     * buffered and appended `flush_period` at a time, whole lines only, so
+     * after a crash the file holds every record up to the last flush.
      */
     struct Task6Logger {
       public:
         Task6Logger(const size_t id, const size_t p, const size_t m, const size_t max_iters,
-                    const std::string filename, size_t print_period = 20);
+                    const std::string filename, size_t print_period = 20,
+                    size_t flush_period = 64);
+
+        /* Appends the buffered records. */
+        ~Task6Logger();
 
-        bool operator()(const population_t &population, const size_t current_iter);
+        bool operator()(const population_view &population, const size_t current_iter);
 
       private:
         const size_t id;            // individual size
@@ -67,10 +81,13 @@ namespace end_criteria {
         const size_t m;             // objective size
         const size_t max_iters;     // maximum number of iterations
         const size_t print_period;  // period at which to print to cout
-        const std::string filename; // name of the json file to save the log
-        nlohmann::json log_data;    // json object to store the log data
-        void sync_to_file();
-        void add_final_results(const population_t &population);
+        const size_t flush_period;  // number of generation records per append
+        const std::string filename; // name of the log file
+        std::string pending;        // records not yet appended, one per line
+        size_t pending_records = 0; // number of lines in `pending`
+        void append(const nlohmann::json &record);
+        void flush();
+        void add_final_results(const population_view &population);
         void log_new_data(size_t count_pareto_front, const size_t current_iter);
     };
 } // namespace end_criteria
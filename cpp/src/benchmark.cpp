@@ -26,7 +26,7 @@ namespace benchmark {
         }
     }
 
-    objective::val_t lotz(const individual_t &x) {
+    objective::val_t lotz(const individual::span &x) {
         return objective::val_t{(double)lotzk(0, x), (double)lotzk(1, x)};
     }
 
@@ -52,7 +52,7 @@ namespace benchmark {
     mlotz_functor::mlotz_functor(const size_t m) : m(m) { assert(m > 1 && m % 2 == 0); }
 
     objective::val_t mlotz_functor::operator()(const individual_t &x) {
-        return mlotz(m, x);
+        return words::mlotz(m, x);
     }
 
     bool is_lotz_pareto_front(const individual_t &x) {
@@ -71,4 +71,50 @@ namespace benchmark {
         }
         return true;
     }
+
+    namespace words {
+        int lotzk(const int k, const individual::span &x) {
+            if (k == 0) {
+                return leading_ones(x);
+            } else if (k == 1) {
+                return trailing_zeros(x);
+            } else {
+                throw std::invalid_argument("Invalid objective index for LOTZ");
+            }
+        }
+
+        int mlotzk(const int m, const int k, const individual::span &x) {
+            assert(k >= 0 && k < m);
+            int n2 = 2 * x.size() / m;
+            return lotzk(k % 2, x.subspan((k / 2) * n2, n2));
+        }
+
+        objective::val_t mlotz(const int m, const individual::span &x) {
+            const int n = x.size();
+            assert(m > 1 && m % 2 == 0);
+            assert(n % (m / 2) == 0);
+            const int len_span = n / (m / 2);
+
+            objective::val_t v(m);
+            for (int k = 0; k < m; k += 2) {
+                individual::span slice = x.subspan((k / 2) * len_span, len_span);
+                v[k] = leading_ones(slice);
+                v[k + 1] = trailing_zeros(slice);
+            }
+            return v;
+        }
+
+        bool is_mlotz_pareto_front(const int m, const individual::span &x) {
+            const int n = x.size();
+            assert(m > 1 && n % (m / 2) == 0);
+            const int len_span = n / (m / 2);
+            for (int k = 0; k < m; k += 2) {
+                individual::span slice = x.subspan((k / 2) * len_span, len_span);
+                // Ones then zeros, i.e. the leading ones end where the trailing zeros start
+                if (leading_ones(slice) + trailing_zeros(slice) != (size_t)len_span)
+                    return false;
+            }
+            return true;
+        }
+    } // namespace words
 } // namespace benchmark
\ No newline at end of file
@@ -0,0 +1,309 @@
+#include "dominance.h"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define PARETO_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace pareto {
+    using individual::word_bits;
+
+    template <typename T>
+    void column_block<T>::assign(const objective::basic_matrix<T> &objectives) {
+        rows_ = objectives.rows();
+        cols_ = objectives.cols();
+        stride_ = individual::words_for(rows_) * word_bits;
+        data_.assign(cols_ * stride_, T());
+        for (size_t i = 0; i < rows_; i++) {
+            std::span<const T> row = objectives[i];
+            for (size_t k = 0; k < cols_; k++)
+                data_[k * stride_ + i] = row[k];
+        }
+    }
+
+    namespace {
+        template <typename T>
+        void scalar_kernel(std::span<const T> point, const column_block<T> &block,
+                           std::span<word_t> better, std::span<word_t> worse) {
+            size_t m = block.cols();
+            for (size_t w = 0; w < better.size(); w++) {
+                word_t b = 0, d = 0;
+                size_t end = std::min(block.rows(), (w + 1) * word_bits);
+                for (size_t j = w * word_bits; j < end; j++) {
+                    // point >= row everywhere and > somewhere, or the reverse
+                    bool ge = true, gt = false, le = true, lt = false;
+                    for (size_t k = 0; k < m && (ge || le); k++) {
+                        T p = point[k], v = block.column(k)[j];
+                        ge &= p >= v;
+                        gt |= p > v;
+                        le &= p <= v;
+                        lt |= p < v;
+                    }
+                    b |= word_t(ge && gt) << (j % word_bits);
+                    d |= word_t(le && lt) << (j % word_bits);
+                }
+                better[w] = b;
+                worse[w] = d;
+            }
+        }
+
+#ifdef PARETO_X86_KERNELS
+        // Each SIMD kernel fills whole words, the bits past the last row are
+        // cleared by `dominates_many`. Integers have no NaN, so a row is
+        // dominated iff it is below somewhere and never above.
+
+        __attribute__((target("avx2"))) void avx2_kernel(std::span<const double> point,
+                                                         const column_block<double> &block,
+                                                         std::span<word_t> better,
+                                                         std::span<word_t> worse) {
+            size_t m = block.cols();
+            const __m256d ones = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+            for (size_t w = 0; w < better.size(); w++) {
+                word_t b = 0, d = 0;
+                for (size_t j = w * word_bits; j < (w + 1) * word_bits; j += 4) {
+                    __m256d ge = ones, gt = _mm256_setzero_pd();
+                    __m256d le = ones, lt = _mm256_setzero_pd();
+                    for (size_t k = 0; k < m; k++) {
+                        __m256d p = _mm256_set1_pd(point[k]);
+                        __m256d v = _mm256_loadu_pd(block.column(k) + j);
+                        ge = _mm256_and_pd(ge, _mm256_cmp_pd(p, v, _CMP_GE_OQ));
+                        gt = _mm256_or_pd(gt, _mm256_cmp_pd(p, v, _CMP_GT_OQ));
+                        le = _mm256_and_pd(le, _mm256_cmp_pd(p, v, _CMP_LE_OQ));
+                        lt = _mm256_or_pd(lt, _mm256_cmp_pd(p, v, _CMP_LT_OQ));
+                    }
+                    b |= word_t(_mm256_movemask_pd(_mm256_and_pd(ge, gt))) << (j % word_bits);
+                    d |= word_t(_mm256_movemask_pd(_mm256_and_pd(le, lt))) << (j % word_bits);
+                }
+                better[w] = b;
+                worse[w] = d;
+            }
+        }
+
+        __attribute__((target("avx2"))) void avx2_kernel(std::span<const int32_t> point,
+                                                         const column_block<int32_t> &block,
+                                                         std::span<word_t> better,
+                                                         std::span<word_t> worse) {
+            size_t m = block.cols();
+            for (size_t w = 0; w < better.size(); w++) {
+                word_t b = 0, d = 0;
+                for (size_t j = w * word_bits; j < (w + 1) * word_bits; j += 8) {
+                    __m256i gt = _mm256_setzero_si256(), lt = _mm256_setzero_si256();
+                    for (size_t k = 0; k < m; k++) {
+                        __m256i p = _mm256_set1_epi32(point[k]);
+                        __m256i v = _mm256_loadu_si256((const __m256i *)(block.column(k) + j));
+                        gt = _mm256_or_si256(gt, _mm256_cmpgt_epi32(p, v));
+                        lt = _mm256_or_si256(lt, _mm256_cmpgt_epi32(v, p));
+                    }
+                    __m256 above = _mm256_castsi256_ps(_mm256_andnot_si256(lt, gt));
+                    __m256 below = _mm256_castsi256_ps(_mm256_andnot_si256(gt, lt));
+                    b |= word_t(_mm256_movemask_ps(above)) << (j % word_bits);
+                    d |= word_t(_mm256_movemask_ps(below)) << (j % word_bits);
+                }
+                better[w] = b;
+                worse[w] = d;
+            }
+        }
+
+        __attribute__((target("avx2"))) void avx2_kernel(std::span<const uint16_t> point,
+                                                         const column_block<uint16_t> &block,
+                                                         std::span<word_t> better,
+                                                         std::span<word_t> worse) {
+            size_t m = block.cols();
+            // Unsigned order as the signed order of the values with a flipped sign bit
+            const __m256i sign = _mm256_set1_epi16(int16_t(0x8000));
+            for (size_t w = 0; w < better.size(); w++) {
+                word_t b = 0, d = 0;
+                for (size_t j = w * word_bits; j < (w + 1) * word_bits; j += 32) {
+                    // Rows j..j+15 in `*0`, j+16..j+31 in `*1`
+                    __m256i gt0 = _mm256_setzero_si256(), lt0 = _mm256_setzero_si256();
+                    __m256i gt1 = _mm256_setzero_si256(), lt1 = _mm256_setzero_si256();
+                    for (size_t k = 0; k < m; k++) {
+                        __m256i p = _mm256_xor_si256(_mm256_set1_epi16(int16_t(point[k])), sign);
+                        const uint16_t *column = block.column(k) + j;
+                        __m256i v0 = _mm256_xor_si256(
+                            _mm256_loadu_si256((const __m256i *)column), sign);
+                        __m256i v1 = _mm256_xor_si256(
+                            _mm256_loadu_si256((const __m256i *)(column + 16)), sign);
+                        gt0 = _mm256_or_si256(gt0, _mm256_cmpgt_epi16(p, v0));
+                        lt0 = _mm256_or_si256(lt0, _mm256_cmpgt_epi16(v0, p));
+                        gt1 = _mm256_or_si256(gt1, _mm256_cmpgt_epi16(p, v1));
+                        lt1 = _mm256_or_si256(lt1, _mm256_cmpgt_epi16(v1, p));
+                    }
+                    // Narrow to one byte per row; packs interleaves the 128-bit
+                    // lanes of its operands, which the permutation restores
+                    __m256i above = _mm256_packs_epi16(_mm256_andnot_si256(lt0, gt0),
+                                                       _mm256_andnot_si256(lt1, gt1));
+                    __m256i below = _mm256_packs_epi16(_mm256_andnot_si256(gt0, lt0),
+                                                       _mm256_andnot_si256(gt1, lt1));
+                    above = _mm256_permute4x64_epi64(above, 0xd8);
+                    below = _mm256_permute4x64_epi64(below, 0xd8);
+                    b |= word_t(uint32_t(_mm256_movemask_epi8(above))) << (j % word_bits);
+                    d |= word_t(uint32_t(_mm256_movemask_epi8(below))) << (j % word_bits);
+                }
+                better[w] = b;
+                worse[w] = d;
+            }
+        }
+
+        __attribute__((target("avx512f,avx512bw"))) void
+        avx512_kernel(std::span<const double> point, const column_block<double> &block,
+                      std::span<word_t> better, std::span<word_t> worse) {
+            size_t m = block.cols();
+            for (size_t w = 0; w < better.size(); w++) {
+                word_t b = 0, d = 0;
+                for (size_t j = w * word_bits; j < (w + 1) * word_bits; j += 8) {
+                    __mmask8 ge = 0xff, gt = 0, le = 0xff, lt = 0;
+                    for (size_t k = 0; k < m; k++) {
+                        __m512d p = _mm512_set1_pd(point[k]);
+                        __m512d v = _mm512_loadu_pd(block.column(k) + j);
+                        ge &= _mm512_cmp_pd_mask(p, v, _CMP_GE_OQ);
+                        gt |= _mm512_cmp_pd_mask(p, v, _CMP_GT_OQ);
+                        le &= _mm512_cmp_pd_mask(p, v, _CMP_LE_OQ);
+                        lt |= _mm512_cmp_pd_mask(p, v, _CMP_LT_OQ);
+                    }
+                    b |= word_t(ge & gt) << (j % word_bits);
+                    d |= word_t(le & lt) << (j % word_bits);
+                }
+                better[w] = b;
+                worse[w] = d;
+            }
+        }
+
+        __attribute__((target("avx512f,avx512bw"))) void
+        avx512_kernel(std::span<const int32_t> point, const column_block<int32_t> &block,
+                      std::span<word_t> better, std::span<word_t> worse) {
+            size_t m = block.cols();
+            for (size_t w = 0; w < better.size(); w++) {
+                word_t b = 0, d = 0;
+                for (size_t j = w * word_bits; j < (w + 1) * word_bits; j += 16) {
+                    __mmask16 gt = 0, lt = 0;
+                    for (size_t k = 0; k < m; k++) {
+                        __m512i p = _mm512_set1_epi32(point[k]);
+                        __m512i v = _mm512_loadu_si512(block.column(k) + j);
+                        gt |= _mm512_cmpgt_epi32_mask(p, v);
+                        lt |= _mm512_cmplt_epi32_mask(p, v);
+                    }
+                    b |= word_t(gt & ~lt) << (j % word_bits);
+                    d |= word_t(lt & ~gt) << (j % word_bits);
+                }
+                better[w] = b;
+                worse[w] = d;
+            }
+        }
+
+        __attribute__((target("avx512f,avx512bw"))) void
+        avx512_kernel(std::span<const uint16_t> point, const column_block<uint16_t> &block,
+                      std::span<word_t> better, std::span<word_t> worse) {
+            size_t m = block.cols();
+            for (size_t w = 0; w < better.size(); w++) {
+                word_t b = 0, d = 0;
+                for (size_t j = w * word_bits; j < (w + 1) * word_bits; j += 32) {
+                    __mmask32 gt = 0, lt = 0;
+                    for (size_t k = 0; k < m; k++) {
+                        __m512i p = _mm512_set1_epi16(int16_t(point[k]));
+                        __m512i v = _mm512_loadu_si512(block.column(k) + j);
+                        gt |= _mm512_cmpgt_epu16_mask(p, v);
+                        lt |= _mm512_cmplt_epu16_mask(p, v);
+                    }
+                    b |= word_t(gt & ~lt) << (j % word_bits);
+                    d |= word_t(lt & ~gt) << (j % word_bits);
+                }
+                better[w] = b;
+                worse[w] = d;
+            }
+        }
+#endif
+    } // namespace
+
+    bool supported(kernel k) {
+        switch (k) {
+        case kernel::scalar:
+            return true;
+#ifdef PARETO_X86_KERNELS
+        case kernel::avx2:
+            return __builtin_cpu_supports("avx2");
+        case kernel::avx512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+        default:
+            return false;
+        }
+    }
+
+    kernel best_kernel() {
+        for (kernel k : {kernel::avx512, kernel::avx2})
+            if (supported(k))
+                return k;
+        return kernel::scalar;
+    }
+
+    const char *to_string(kernel k) {
+        switch (k) {
+        case kernel::scalar:
+            return "scalar";
+        case kernel::avx2:
+            return "avx2";
+        case kernel::avx512:
+            return "avx512";
+        }
+        throw std::invalid_argument("Unknown dominance kernel");
+    }
+
+    template <typename T>
+    void dominates_many(std::span<const T> point, const column_block<T> &block,
+                        std::span<word_t> better, std::span<word_t> worse) {
+        // Resolved once, on the first call
+        static const kernel best = best_kernel();
+        dominates_many(best, point, block, better, worse);
+    }
+
+    template <typename T>
+    void dominates_many(kernel k, std::span<const T> point, const column_block<T> &block,
+                        std::span<word_t> better, std::span<word_t> worse) {
+        assert(point.size() == block.cols());
+        assert(better.size() == individual::words_for(block.rows()));
+        assert(worse.size() == better.size());
+        if (!supported(k))
+            throw std::invalid_argument(std::string("Unsupported dominance kernel: ") +
+                                        to_string(k));
+        switch (k) {
+        case kernel::scalar:
+            scalar_kernel(point, block, better, worse);
+            return;
+#ifdef PARETO_X86_KERNELS
+        case kernel::avx2:
+            avx2_kernel(point, block, better, worse);
+            break;
+        case kernel::avx512:
+            avx512_kernel(point, block, better, worse);
+            break;
+#endif
+        default:
+            throw std::invalid_argument("Unsupported dominance kernel");
+        }
+        // Clear the bits of the padding rows
+        if (size_t tail = block.rows() % word_bits; tail != 0) {
+            better.back() &= (word_t(1) << tail) - 1;
+            worse.back() &= (word_t(1) << tail) - 1;
+        }
+    }
+
+    template class column_block<double>;
+    template class column_block<int32_t>;
+    template class column_block<uint16_t>;
+
+#define PARETO_INSTANTIATE(T)                                                                      \
+    template void dominates_many(std::span<const T>, const column_block<T> &, std::span<word_t>,  \
+                                 std::span<word_t>);                                               \
+    template void dominates_many(kernel, std::span<const T>, const column_block<T> &,             \
+                                 std::span<word_t>, std::span<word_t>);
+
+    PARETO_INSTANTIATE(double)
+    PARETO_INSTANTIATE(int32_t)
+    PARETO_INSTANTIATE(uint16_t)
+#undef PARETO_INSTANTIATE
+} // namespace pareto
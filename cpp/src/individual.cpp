@@ -1,65 +1,105 @@
 #include "individual.h"
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <iostream>
 #include <stdexcept>
 
 namespace individual {
-    individual_t operator&(const individual_t &a, const individual_t &b) {
-        if (a.size() != b.size()) {
-            throw std::invalid_argument("differently sized bitwise operands");
+    genome::genome(std::initializer_list<uint8_t> genes) : genome(genes.size()) {
+        size_t i = 0;
+        for (uint8_t gene : genes) {
+            if (gene) {
+                set(i);
+            }
+            ++i;
         }
+    }
 
-        individual_t result(a.size());
-        for (size_t i = 0; i < a.size(); ++i) {
-            result[i] = a[i] & b[i];
+    genome::genome(const bytes_t &genes) : genome(genes.size()) {
+        for (size_t i = 0; i < genes.size(); ++i) {
+            if (genes[i]) {
+                set(i);
+            }
         }
-        return result;
     }
 
-    individual_t operator|(const individual_t &a, const individual_t &b) {
-        if (a.size() != b.size()) {
+    genome &genome::operator&=(const genome &other) {
+        if (size_ != other.size_) {
             throw std::invalid_argument("differently sized bitwise operands");
         }
-
-        individual_t result(a.size());
-        for (size_t i = 0; i < a.size(); ++i) {
-            result[i] = a[i] | b[i];
+        for (size_t i = 0; i < words_.size(); ++i) {
+            words_[i] &= other.words_[i];
         }
-        return result;
+        return *this;
     }
 
-    individual_t operator^(const individual_t &a, const individual_t &b) {
-        if (a.size() != b.size()) {
+    genome &genome::operator|=(const genome &other) {
+        if (size_ != other.size_) {
             throw std::invalid_argument("differently sized bitwise operands");
         }
+        for (size_t i = 0; i < words_.size(); ++i) {
+            words_[i] |= other.words_[i];
+        }
+        return *this;
+    }
 
-        individual_t result(a.size());
-        for (size_t i = 0; i < a.size(); ++i) {
-            result[i] = a[i] ^ b[i];
+    genome &genome::operator^=(const genome &other) {
+        if (size_ != other.size_) {
+            throw std::invalid_argument("differently sized bitwise operands");
         }
+        for (size_t i = 0; i < words_.size(); ++i) {
+            words_[i] ^= other.words_[i];
+        }
+        return *this;
+    }
+
+    individual_t operator&(const individual_t &a, const individual_t &b) {
+        individual_t result = a;
+        result &= b;
+        return result;
+    }
+
+    individual_t operator|(const individual_t &a, const individual_t &b) {
+        individual_t result = a;
+        result |= b;
+        return result;
+    }
+
+    individual_t operator^(const individual_t &a, const individual_t &b) {
+        individual_t result = a;
+        result ^= b;
         return result;
     }
 
     individual_t operator~(const individual_t &a) {
-        individual_t result(a.size());
-        for (size_t i = 0; i < a.size(); ++i) {
-            result[i] = ~a[i];
+        individual_t result = a;
+        result.flip();
+        return result;
+    }
+
+    bytes_t to_bytes(const individual_t &x) {
+        bytes_t result(x.size());
+        for (size_t i = 0; i < x.size(); ++i) {
+            result[i] = x[i];
         }
         return result;
     }
 
-    std::ostream &operator<<(std::ostream &os, const individual_t &x) {
+    individual_t from_bytes(const bytes_t &x) { return individual_t(x); }
+
+    std::ostream &operator<<(std::ostream &os, const genome_view &x) {
         for (auto b : x) {
             os << (b ? '1' : '0');
         }
         return os;
     }
 
-    std::string to_string(const individual_t &x) {
+    std::string to_string(const genome_view &x) {
         size_t n = x.size();
         std::string result(n, '0');
         for (size_t i = 0; i < n; ++i) {
-            result[i] = (x[i] == 0) ? '0' : '1';
+            result[i] = x[i] ? '1' : '0';
         }
         return result;
     }
@@ -69,19 +109,15 @@ namespace individual {
         size_t bits = 0;
         int n = x.size();
         for (int k = 0; k < n; ++k) {
-            bits |= (x[k] & 1) * (1 << (n - 1 - k));
+            bits |= (size_t)x[k] << (n - 1 - k);
         }
         return bits;
     }
 
     size_t to_bits_le(const individual_t &x) {
         assert(x.size() <= (sizeof(size_t) << 3));
-        size_t bits = 0;
-        int n = x.size();
-        for (int k = 0; k < n; ++k) {
-            bits |= (x[k] & 1) * (1 << k);
-        }
-        return bits;
+        // Gene k is already stored at bit k of the first word
+        return x.size() > 0 ? x.words()[0] : 0;
     }
 
     using objective::fn_t;
@@ -123,29 +159,11 @@ namespace objective {
 } // namespace objective
 
 namespace pareto {
-    order compare(const val_t &a, const val_t &b) {
-        size_t n = a.size();
-        assert(n == b.size());
-
-        order out = order::equivalent;
-        for (size_t i = 0; i < n; ++i) {
-            double ai = a[i];
-            double bi = b[i];
-            if (ai == bi) {
-                continue;
-            }
-            order cmp = ai <=> bi;
-            if (out != order::equivalent && cmp != out) {
-                return order::unordered;
-            }
-            out = cmp;
-        }
-        return out;
-    }
+    order compare(row_t a, row_t b) { return compare<double>(a, b); }
 
-    bool strictly_dominates(const val_t &a, const val_t &b) { return compare(a, b) > 0; }
+    bool strictly_dominates(row_t a, row_t b) { return compare(a, b) > 0; }
 
     /* Returns `true` if the left objective value Pareto-dominates
         the right value. */
-    bool dominates(const val_t &a, const val_t &b) { return compare(a, b) >= 0; }
+    bool dominates(row_t a, row_t b) { return compare(a, b) >= 0; }
 }; // namespace pareto
\ No newline at end of file
@@ -1,30 +1,90 @@
 #include "benchmark.h"
 #include "cxxopts.hpp"
+#include "evaluation.h"
 #include "nsga2.h"
+#include "profiling.h"
+#include "rng.h"
+#include "sorting.h"
+#include "static_nsga2.h"
 #include "utils.h"
 #include <cstddef>
+#include <filesystem>
+#include <limits>
 #include <print>
+#include <random>
+#include <tuple>
+#include <type_traits>
 
+/* The file next to the log `filename` where `--profile` writes its results. */
+std::string profile_filename(const std::string &filename) {
+    std::filesystem::path path(filename);
+    path.replace_extension(".profile.json");
+    return path.string();
+}
+
+template <typename Gen, typename Value, typename Profiler>
 void fire(size_t individual_size, size_t population_size, size_t max_iters, size_t objective_size,
-          uint32_t seed, std::string filename) {
-    using benchmark::mlotz_functor;
+          uint32_t seed, std::string filename, sorting::strategy sort_strategy,
+          nsga2::selection_t selection, size_t threads) {
     using end_criteria::Task6Logger;
 
     assert(objective_size % 2 == 0);
     assert(individual_size % (objective_size / 2) == 0);
 
-    auto f = mlotz_functor(objective_size);
-
-    individual::individual_t dummy_individual(individual_size, 0);
-    assert(f(dummy_individual).size() == objective_size);
+    // Evaluated in batches, with one virtual call per batch
+    auto f = objective::make_batch_objective<typename Value::value_type>(
+        benchmark::mlotz_functor(objective_size));
 
     auto criterion = end_criteria::Task6Logger(individual_size, population_size, objective_size,
                                                max_iters, filename, 2);
 
-    auto experiment = nsga2::NSGA2(individual_size, objective_size, population_size, f, seed);
+    auto experiment = nsga2::NSGA2<Gen, Value, Profiler>(individual_size, objective_size,
+                                                         population_size, f, seed);
+    experiment.set_sort_strategy(sort_strategy);
+    experiment.set_selection(selection);
+    experiment.set_threads(threads);
+    nsga2::population_t pop = experiment.run(criterion);
+
+    if constexpr (Profiler::enabled) {
+        std::string path = profile_filename(filename);
+        std::println("Saving profile to {0}", path);
+        experiment.profile().save(path);
+    }
+}
+
+template <size_t N, size_t M, typename Gen>
+void fire_static(size_t population_size, size_t max_iters, uint32_t seed, std::string filename,
+                 sorting::strategy sort_strategy, nsga2::selection_t selection, size_t threads) {
+    auto criterion = end_criteria::Task6Logger(N, population_size, M, max_iters, filename, 2);
+
+    auto experiment = nsga2::StaticNSGA2<N, M, benchmark::static_mlotz<N, M>, Gen>(
+        population_size, benchmark::static_mlotz<N, M>(), seed);
+    experiment.set_sort_strategy(sort_strategy);
+    experiment.set_selection(selection);
+    experiment.set_threads(threads);
     nsga2::population_t pop = experiment.run(criterion);
 }
 
+// The (n, m) configurations compiled with a static genome, see `--static`
+template <size_t N, size_t M>
+struct static_config {};
+using static_configs_t = std::tuple<static_config<10, 2>, static_config<20, 2>,
+                                    static_config<16, 4>, static_config<32, 4>,
+                                    static_config<24, 8>, static_config<48, 8>>;
+
+/* Runs `fire_static` if (n, m) is a static configuration, and returns whether it did. */
+template <typename Gen, typename... Args>
+bool try_fire_static(size_t individual_size, size_t objective_size, Args... args) {
+    auto attempt = [&]<size_t N, size_t M>(static_config<N, M>) {
+        if (individual_size != N || objective_size != M)
+            return false;
+        fire_static<N, M, Gen>(args...);
+        return true;
+    };
+    return std::apply([&](auto... configs) { return (attempt(configs) || ...); },
+                      static_configs_t());
+}
+
 int main(int argc, char **argv) {
     using namespace cxxopts;
     // clang-format off
@@ -36,6 +96,19 @@ int main(int argc, char **argv) {
       ("max_iters", "Maximum number of iterations", value<size_t>())
       ("seed", "Seed for the random number generator", value<uint32_t>())
       ("filename", "Name of the json file to save the log", value<std::string>())
+      ("sort", "Non-dominated sorting engine: auto, graph, deb, ens-ss, ens-bs, 2d, dc",
+       value<std::string>()->default_value("auto"))
+      ("rng", "Random number generator: xoshiro, pcg, philox, mt19937",
+       value<std::string>()->default_value("xoshiro"))
+      ("threads", "Number of threads mutating and evaluating the offspring",
+       value<size_t>()->default_value("1"))
+      ("values", "Objective value type: double, or compact for 16-bit integers (mLOTZ)",
+       value<std::string>()->default_value("double"))
+      ("static", "Use the compile-time specialized NSGA-II when (n, m) is one of "
+                 "(10, 2), (20, 2), (16, 4), (32, 4), (24, 8), (48, 8)")
+      ("modified", "Run the modified NSGA-II, which updates crowding distances during selection")
+      ("profile", "Time each phase of the runtime-sized NSGA-II and save the results next to "
+                  "the log, as <filename>.profile.json")
       ("h,help", "Print usage");
     // clang-format on
 
@@ -52,8 +125,71 @@ int main(int argc, char **argv) {
     size_t max_iters = result["max_iters"].as<size_t>();
     uint32_t seed = result["seed"].as<uint32_t>();
     std::string filename = result["filename"].as<std::string>();
+    sorting::strategy sort_strategy = sorting::parse_strategy(result["sort"].as<std::string>());
+
+    nsga2::selection_t selection = result.count("modified")
+                                       ? nsga2::selection_t::dynamic
+                                       : nsga2::selection_t::crowding_distance;
+
+    size_t threads = result["threads"].as<size_t>();
+
+    std::string values = result["values"].as<std::string>();
+    if (values != "double" && values != "compact") {
+        std::println("Unknown objective value type: {0}", values);
+        return 1;
+    }
+    using compact_t = objective::compact_val_t::value_type;
+    if (values == "compact" &&
+        individual_size / (objective_size / 2) > std::numeric_limits<compact_t>::max()) {
+        std::println("--values compact holds mLOTZ values up to {0}, but n / (m / 2) = {1}",
+                     std::numeric_limits<compact_t>::max(), individual_size / (objective_size / 2));
+        return 1;
+    }
+
+    bool profile = result.count("profile");
 
-    fire(individual_size, population_size, max_iters, objective_size, seed, filename);
+    // Runs with the generator `Gen` of the tag `std::type_identity<Gen>`
+    auto run = [&](auto generator_tag) {
+        using Gen = typename decltype(generator_tag)::type;
+        if (result.count("static") && profile) {
+            std::println("--profile instruments the runtime-sized NSGA-II, ignoring --static");
+        } else if (result.count("static")) {
+            if (try_fire_static<Gen>(individual_size, objective_size, population_size, max_iters,
+                                     seed, filename, sort_strategy, selection, threads))
+                return;
+            std::println("No static configuration for n = {0} and m = {1}, "
+                         "using the runtime-sized NSGA-II",
+                         individual_size, objective_size);
+        }
+        // Runs with the objective values `Value` and the profiler `Profiler`
+        auto fire_with = [&]<typename Value, typename Profiler>() {
+            fire<Gen, Value, Profiler>(individual_size, population_size, max_iters,
+                                       objective_size, seed, filename, sort_strategy, selection,
+                                       threads);
+        };
+        if (values == "compact" && profile)
+            fire_with.template operator()<objective::compact_val_t, profiling::recorder>();
+        else if (values == "compact")
+            fire_with.template operator()<objective::compact_val_t, profiling::none>();
+        else if (profile)
+            fire_with.template operator()<objective::val_t, profiling::recorder>();
+        else
+            fire_with.template operator()<objective::val_t, profiling::none>();
+    };
+
+    std::string generator = result["rng"].as<std::string>();
+    if (generator == "xoshiro") {
+        run(std::type_identity<rng::xoshiro256ss>());
+    } else if (generator == "pcg") {
+        run(std::type_identity<rng::pcg64>());
+    } else if (generator == "philox") {
+        run(std::type_identity<rng::philox4x32>());
+    } else if (generator == "mt19937") {
+        run(std::type_identity<std::mt19937>());
+    } else {
+        std::println("Unknown random number generator: {0}", generator);
+        return 1;
+    }
 
     std::println("Done!");
     return 0;
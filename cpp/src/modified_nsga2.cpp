@@ -1 +1,112 @@
-// TODO Implement the modified NSGA-II algorithm
\ No newline at end of file
+#include "modified_nsga2.h"
+#include "binaryheap.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace modified_nsga2 {
+    using binary_heap::DenseHeap;
+    using binary_heap::Node;
+
+    const double eps = 1e-8;
+
+    // Marks the ends of the doubly linked lists
+    const size_t none = std::numeric_limits<size_t>::max();
+
+    template <typename T>
+    front_t dynamic_crowding_select(const objective::basic_matrix<T> &objectives,
+                                    const front_t &front, const size_t keep) {
+        size_t size = front.size();
+        if (keep >= size)
+            return front;
+        size_t m = objectives.cols();
+        const double inf = std::numeric_limits<double>::infinity();
+
+        // For each objective, the positions of the front sorted by value are
+        // kept as a doubly linked list, so that removals are O(1)
+        std::vector<size_t> prev(m * size), next(m * size);
+        std::vector<double> range(m);
+        std::vector<size_t> order(size);
+        for (size_t k = 0; k < m; k++) {
+            for (size_t p = 0; p < size; p++)
+                order[p] = p;
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+                return objectives[front[a]][k] < objectives[front[b]][k];
+            });
+            for (size_t j = 0; j < size; j++) {
+                prev[k * size + order[j]] = j > 0 ? order[j - 1] : none;
+                next[k * size + order[j]] = j + 1 < size ? order[j + 1] : none;
+            }
+            // Added eps to avoid division by zero
+            range[k] = double(objectives[front[order[size - 1]]][k]) -
+                       double(objectives[front[order[0]]][k]) + eps;
+        }
+
+        // The crowding distance of a position given its current neighbours. O(m)
+        auto distance = [&](size_t p) {
+            double d = 0.0;
+            for (size_t k = 0; k < m; k++) {
+                size_t a = prev[k * size + p];
+                size_t b = next[k * size + p];
+                if (a == none || b == none)
+                    return inf;
+                double gap = double(objectives[front[b]][k]) - double(objectives[front[a]][k]);
+                d += gap / range[k];
+            }
+            return d;
+        };
+
+        // O(mN + NlogN)
+        DenseHeap<double, size_t, 4> heap(size);
+        std::vector<double> current(size);
+        for (size_t p = 0; p < size; p++) {
+            current[p] = distance(p);
+            heap.emplace(Node<double, size_t>{.key = current[p], .id = p});
+        }
+
+        // O(mNlogN): each removal updates at most 2m neighbours
+        std::vector<bool> removed(size, false);
+        for (size_t r = keep; r < size; r++) {
+            size_t p = heap.extract_min().id;
+            removed[p] = true;
+            for (size_t k = 0; k < m; k++) {
+                size_t a = prev[k * size + p];
+                size_t b = next[k * size + p];
+                if (a != none)
+                    next[k * size + a] = b;
+                if (b != none)
+                    prev[k * size + b] = a;
+            }
+            for (size_t k = 0; k < m; k++) {
+                for (size_t q : {prev[k * size + p], next[k * size + p]}) {
+                    if (q == none)
+                        continue;
+                    // Removing a neighbour only widens the gap around `q`
+                    double d = distance(q);
+                    if (d > current[q]) {
+                        current[q] = d;
+                        heap.increase_key(q, d);
+                    }
+                }
+            }
+        }
+
+        front_t kept;
+        kept.reserve(keep);
+        for (size_t p = 0; p < size; p++)
+            if (!removed[p])
+                kept.push_back(front[p]);
+        assert(kept.size() == keep);
+        return kept;
+    }
+
+    template front_t dynamic_crowding_select(const objective::basic_matrix<double> &,
+                                             const front_t &, const size_t);
+    template front_t dynamic_crowding_select(const objective::basic_matrix<int32_t> &,
+                                             const front_t &, const size_t);
+    template front_t dynamic_crowding_select(const objective::basic_matrix<uint16_t> &,
+                                             const front_t &, const size_t);
+} // namespace modified_nsga2
@@ -1,13 +1,21 @@
 #include "nsga2.h"
-#include "graph.h"
+#include "evaluation.h"
 #include "individual.h"
+#include "modified_nsga2.h"
+#include "mutation.h"
+#include "sorting.h"
 #include "utils.h"
 #include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <cmath>
 #include <print>
+#include <limits>
+#include <numeric>
 #include <random>
-#include <unordered_map>
+#include <span>
+#include <stdexcept>
+#include <vector>
 
 const double eps = 1e-8;
 
@@ -15,147 +23,272 @@ using end_criteria::criterion_t; // callable terminating condition
 
 namespace nsga2 {
 
-    NSGA2::NSGA2(const size_t individual_size, const size_t objective_size,
-                 const size_t population_size, const objective::fn_t &f, const double mutation_rate,
-                 const uint32_t seed)
-        : individual_size(individual_size), objective_size(objective_size),
-          population_size(population_size), mutation_rate(mutation_rate), dist(mutation_rate),
-          gen(seed), f(f) {
-        individual_t dummy_individual(individual_size);
-        std::println("Initializing NSGA2 with the following parameters:");
-        std::println("Individual Size: {0}", individual_size);
-        std::println("Objective Size: {0}", objective_size);
-        std::println("Population Size: {0}", population_size);
-        std::println("Mutation Rate: {0}", mutation_rate);
-        std::println("Seed: {0}", seed);
-    }
-
-    NSGA2::NSGA2(const size_t individual_size, const size_t objective_size,
-                 const size_t population_size, const objective::fn_t f, const uint32_t seed)
-        : NSGA2(individual_size, objective_size, population_size, f, 1.0 / (double)individual_size,
-                seed) {}
-
-    void NSGA2::mutate(population_t &population) {
-        population.resize(population_size * 2);
-        for (int i = population_size; i < population_size * 2; i++) {
-            population[i] = population[i - population_size];
-            for (int j = 0; j < individual_size; j++) {
-                if (generate_mutation_bit()) {
-                    population[i][j] = !population[i][j];
-                }
-            }
-        }
+    void selection_buffers::reserve(size_t population_size, size_t objective_size) {
+        selected.reserve(population_size);
+        last_front.reserve(2 * population_size);
+        distances.reserve(2 * population_size);
+        columns.reserve(2 * population_size * objective_size);
+        order.reserve(2 * population_size);
     }
 
-    fronts_t NSGA2::non_dominated_sort(const population_t &population) {
-        // TODO Performance improvements
-        Graph<index_t> graph;
-        size_t size = population.size();
-        // O(N) N = population size
-        for (index_t i = 0; i < size; i++)
-            graph.add_node(i);
-        // O(N^2) Is there a clever way to do this? e.g. dynamic pruning?
-        // The graph could be dense here
-        for (index_t i = 0; i < size; i++)
-            for (index_t j = 0; j < size; j++) {
-                if (individual::strictly_dominates(population[i], population[j], f)) {
-                    graph.add_edge(i, j);
-                }
-            }
-        // O(N^2)
-        return graph.pop_and_get_fronts();
-    }
-
-    scores_t NSGA2::crowding_distance(const population_t &population, front_t &indices) {
-        // TODO Test & Performance improvements
-        size_t size = indices.size();
+    template <typename T>
+    const scores_t &crowding_distance(const objective::basic_matrix<T> &objectives,
+                                      std::span<const index_t> front, selection_buffers &buffers) {
+        size_t size = front.size();
+        size_t objective_size = objectives.cols();
         assert(size > 0);
-        scores_t distances;
-        std::unordered_map<index_t, val_t> values;
-        // initialize the distances
-        for (index_t idx : indices) {
-            distances[idx] = 0.0;
-            values[idx] = f(population[idx]);
+        scores_t &distances = buffers.distances;
+        std::vector<double> &columns = buffers.columns;
+        std::vector<size_t> &order = buffers.order;
+        distances.assign(size, 0.0);
+        // Gather the values of the front in one contiguous column per objective
+        columns.resize(objective_size * size);
+        for (size_t p = 0; p < size; p++) {
+            auto value = objectives[front[p]];
+            for (size_t m = 0; m < objective_size; m++)
+                columns[m * size + p] = value[m];
         }
-        // for each objective
+        // Positions in the front, sorted by each objective in turn
+        order.resize(size);
+        const double inf = std::numeric_limits<double>::infinity();
         for (size_t m = 0; m < objective_size; m++) {
+            const double *column = columns.data() + m * size;
+            for (size_t p = 0; p < size; p++)
+                order[p] = p;
             // sort the front based on the objective by ascending order of the values O(NlogN)
-            std::sort(indices.begin(), indices.end(),
-                      [&](index_t a, index_t b) { return values[a][m] < values[b][m]; });
+            std::sort(order.begin(), order.end(),
+                      [column](size_t a, size_t b) { return column[a] < column[b]; });
             // set the boundary points to infinity
-            double inf = std::numeric_limits<double>::infinity();
-            distances[indices[0]] = inf;
-            distances[indices[size - 1]] = inf;
+            distances[order[0]] = inf;
+            distances[order[size - 1]] = inf;
             // Added eps to avoid division by zero
             // This avoids problems with 0 / 0
-            double d = values[indices[size - 1]][m] - values[indices[0]][m] + eps;
-            // O(N), recall that `distances` is a hash map
+            double d = column[order[size - 1]] - column[order[0]] + eps;
+            // O(N)
             for (size_t j = 1; j < size - 1; j++) {
-                if (std::isinf(distances[indices[j]]))
+                if (std::isinf(distances[order[j]]))
                     continue;
-                distances[indices[j]] +=
-                    (values[indices[j + 1]][m] - values[indices[j - 1]][m]) / d;
+                distances[order[j]] += (column[order[j + 1]] - column[order[j - 1]]) / d;
             }
         }
         return distances;
     }
 
-    population_t NSGA2::crowding_distance_select(population_t &population, fronts_t &fronts) {
-        // TODO Test & Performance improvements
-        population_t new_population;
-        size_t target_size = population_size;
+    template <typename T, profiling::profiler Profiler>
+    size_t select_survivors(const objective::basic_matrix<T> &objectives,
+                            const sorting::sorter<T, Profiler::enabled> &fronts,
+                            size_t target_size,
+                            selection_t selection, selection_buffers &buffers,
+                            Profiler &profiler) {
+        front_t &selected = buffers.selected;
+        selected.clear();
         size_t front_idx = 0;
 
         // select low ranked fronts until the target size is reached
         for (front_idx = 0; front_idx < fronts.size(); front_idx++) {
-            front_t &front = fronts[front_idx];
-            if (new_population.size() + front.size() > target_size)
+            std::span<const index_t> front = fronts[front_idx];
+            if (selected.size() + front.size() > target_size)
                 break;
-            for (index_t idx : front)
-                new_population.push_back(std::move(population[idx]));
+            selected.insert(selected.end(), front.begin(), front.end());
         }
-        if (new_population.size() == target_size)
-            return new_population;
-
-        // crowding distance selection
-        front_t &front = fronts[front_idx];
-        // O(mNlogN) N is the size of the front, m is the number of objectives
-        scores_t scores = std::move(crowding_distance(population, front));
-        size_t remaining = target_size - new_population.size();
-        // O(NlogN) in the worst case
-        std::partial_sort(front.begin(), front.begin() + remaining, front.end(),
-                          [&](index_t a, index_t b) { return scores[a] > scores[b]; });
-        // O(N) in the worst case: select the individuals with the highest crowding distance
-        // TODO: break ties uniformly at random
-        for (size_t i = 0; i < remaining; i++) {
-            new_population.push_back(std::move(population[front[i]]));
+        // The front split by the selection, if any
+        profiler.add_last_front(selected.size() < target_size ? fronts[front_idx].size() : 0);
+        // The survivors from `selected[crowded]` on are kept by crowding distance
+        size_t crowded = target_size;
+        if (selected.size() < target_size && selection == selection_t::dynamic) {
+            // modified NSGA-II: crowding distances are updated after each removal
+            buffers.last_front.assign(fronts[front_idx].begin(), fronts[front_idx].end());
+            front_t kept = modified_nsga2::dynamic_crowding_select(objectives, buffers.last_front,
+                                                                   target_size - selected.size());
+            selected.insert(selected.end(), kept.begin(), kept.end());
+        } else if (selected.size() < target_size) {
+            // crowding distance selection
+            std::span<const index_t> front = fronts[front_idx];
+            // O(mNlogN) N is the size of the front, m is the number of objectives
+            {
+                profiling::timer<Profiler> timer(profiler, profiling::phase::crowding_distance);
+                crowding_distance(objectives, front, buffers);
+            }
+            const scores_t &scores = buffers.distances;
+            size_t remaining = target_size - selected.size();
+            std::vector<size_t> &order = buffers.order;
+            order.resize(front.size());
+            for (size_t p = 0; p < front.size(); p++)
+                order[p] = p;
+            // O(NlogN) in the worst case
+            std::partial_sort(order.begin(), order.begin() + remaining, order.end(),
+                              [&scores](size_t a, size_t b) { return scores[a] > scores[b]; });
+            // O(N) in the worst case: select the individuals with the highest crowding distance
+            // TODO: break ties uniformly at random
+            crowded = selected.size();
+            for (size_t i = 0; i < remaining; i++) {
+                selected.push_back(front[order[i]]);
+            }
         }
-        if (new_population.size() != target_size) {
-            throw std::runtime_error("new_population.size() != target_size. "
+        if (selected.size() != target_size) {
+            throw std::runtime_error("buffers.selected.size() != target_size. "
                                      "check if there is a bug.");
         }
-        return new_population;
+        return crowded;
     }
 
-    void NSGA2::init_population(const size_t individual_size,
-                                const size_t population_size) { // Tested
-        std::println("Initializing population");
-        std::bernoulli_distribution distribution(0.5);
-        population.resize(population_size);
-
-        int mutation_cnt = 0;
-        for (auto &individual : population) {
-            individual.resize(individual_size);
-            for (auto &gene : individual) {
-                gene = distribution(this->gen);
-                mutation_cnt += gene;
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    NSGA2<Gen, Value, Profiler>::NSGA2(const size_t individual_size, const size_t objective_size,
+                                       const size_t population_size, const value_fn_t &f,
+                                       const double mutation_rate, const uint32_t seed)
+        : NSGA2(individual_size, objective_size, population_size,
+                std::make_shared<const objective::function_objective<typename Value::value_type,
+                                                                     Value>>(f, objective_size),
+                mutation_rate, seed) {}
+
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    NSGA2<Gen, Value, Profiler>::NSGA2(const size_t individual_size, const size_t objective_size,
+                                       const size_t population_size, batch_fn_t f,
+                                       const double mutation_rate, const uint32_t seed)
+        : individual_size(individual_size), population_size(population_size),
+          objective_size(objective_size), mutation_rate(mutation_rate), f(std::move(f)),
+          seed(seed), mutation(mutation_rate) {
+        if (this->f->objectives() != objective_size)
+            throw std::invalid_argument("NSGA2: the objective has the wrong number of values");
+        std::println("Initializing NSGA2 with the following parameters:");
+        std::println("Individual Size: {0}", individual_size);
+        std::println("Objective Size: {0}", objective_size);
+        std::println("Population Size: {0}", population_size);
+        std::println("Mutation Rate: {0}", mutation_rate);
+        std::println("Seed: {0}", seed);
+    }
+
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    NSGA2<Gen, Value, Profiler>::NSGA2(const size_t individual_size, const size_t objective_size,
+                                       const size_t population_size, const value_fn_t f,
+                                       const uint32_t seed)
+        : NSGA2(individual_size, objective_size, population_size, f, 1.0 / (double)individual_size,
+                seed) {}
+
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    NSGA2<Gen, Value, Profiler>::NSGA2(const size_t individual_size, const size_t objective_size,
+                                       const size_t population_size, batch_fn_t f,
+                                       const uint32_t seed)
+        : NSGA2(individual_size, objective_size, population_size, std::move(f),
+                1.0 / (double)individual_size, seed) {}
+
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    void NSGA2<Gen, Value, Profiler>::evaluate(index_t first, size_t count) {
+        profiling::timer<Profiler> timer(profiler, profiling::phase::evaluate);
+        f->evaluate(population.view().subview(first, count),
+                    population.objectives().row_range(first, count));
+    }
+
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    void NSGA2<Gen, Value, Profiler>::mutate() {
+        profiling::timer<Profiler> timer(profiler, profiling::phase::mutate);
+        const bool delta = f->has_delta();
+        values_t &objectives = population.objectives();
+        pool->parallel_for(population_size, [&](size_t begin, size_t end) {
+            // A private copy, the distributions of the operator are not shared
+            mutation::bitwise bitwise = mutation;
+            // The buffer of this thread, large enough for any number of flips
+            std::vector<size_t> &flipped = flipped_by_thread[parallel::ThreadPool::index()];
+            for (size_t c = begin; c < end; c++) {
+                // The child of the parent c draws from the stream (generation, c)
+                Gen gen = rng::stream<Gen>(seed, generation, c);
+                index_t i = population_size + c;
+                population.assign(i, population, c);
+                individual::genome_ref child = population.row(i);
+                if (delta) {
+                    // Same draws, the child is evaluated from its parent
+                    flipped.clear();
+                    flips[c] = bitwise(child, gen, flipped);
+                    profiling::timer<Profiler> evaluation(profiler, profiling::phase::evaluate);
+                    f->evaluate_delta(child, objectives[c], flipped, objectives.row(i));
+                } else {
+                    flips[c] = bitwise(child, gen);
+                }
             }
+            // Otherwise the children of the chunk are evaluated in one batch
+            if (!delta)
+                evaluate(population_size + begin, end - begin);
+        });
+        successful_mutations += std::reduce(flips.begin(), flips.end(), size_t(0));
+        mutation_attempts += individual_size * population_size;
+    }
+
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    void NSGA2<Gen, Value, Profiler>::non_dominated_sort(const values_t &objectives) {
+        {
+            profiling::timer<Profiler> timer(profiler, profiling::phase::non_dominated_sort);
+            fronts.sort(objectives, sort_strategy, pool.get());
+        }
+        if constexpr (Profiler::enabled)
+            profiler.add_sort(fronts.comparisons(), fronts.size());
+    }
+
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    void NSGA2<Gen, Value, Profiler>::set_sort_strategy(const sorting::strategy strategy) {
+        sort_strategy = strategy;
+    }
+
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    void NSGA2<Gen, Value, Profiler>::set_selection(const selection_t selection) {
+        this->selection = selection;
+    }
+
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    void NSGA2<Gen, Value, Profiler>::set_threads(const size_t threads) {
+        pool = std::make_unique<parallel::ThreadPool>(threads);
+    }
+
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    void NSGA2<Gen, Value, Profiler>::crowding_distance_select() {
+        profiling::timer<Profiler> timer(profiler, profiling::phase::select);
+        size_t target_size = population_size;
+        size_t crowded = select_survivors(population.objectives(), fronts, target_size, selection,
+                                          buffers, profiler);
+
+        // Copy the survivors into the first rows of the next arena, with
+        // their values, rank and distance, then swap the arenas. The rows
+        // [N, 2N) are overwritten by the next generation.
+        for (size_t i = 0; i < target_size; i++) {
+            index_t s = buffers.selected[i];
+            next_population.assign(i, population, s);
+            next_population.ranks()[i] = fronts.rank(s);
+            next_population.distances()[i] =
+                i < crowded ? 0.0 : buffers.distances[buffers.order[i - crowded]];
         }
+        std::swap(population, next_population);
+    }
+
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    void NSGA2<Gen, Value, Profiler>::init_population(const size_t individual_size,
+                                                      const size_t population_size) { // Tested
+        std::println("Initializing population");
+        population = arena_t(2 * population_size, individual_size, objective_size);
+        next_population = arena_t(2 * population_size, individual_size, objective_size);
+        buffers.reserve(population_size, objective_size);
+        flipped_by_thread.resize(pool->size());
+        for (std::vector<size_t> &flipped : flipped_by_thread)
+            flipped.reserve(individual_size);
+
+        generation = 0;
+        flips.resize(population_size);
+        pool->parallel_for(population_size, [&](size_t begin, size_t end) {
+            for (index_t i = begin; i < end; i++) {
+                // Uniform genes, 64 per random word of the stream (0, i)
+                Gen gen = rng::stream<Gen>(seed, generation, i);
+                individual::genome_ref x = population.row(i);
+                rng::fill(gen, x.words());
+                x.trim();
+                flips[i] = x.count();
+            }
+            evaluate(begin, end - begin);
+        });
+        size_t mutation_cnt = std::reduce(flips.begin(), flips.end(), size_t(0));
         std::println("Mutation success rate(~0.5): {0}",
                      (double)mutation_cnt / (individual_size * population_size));
     }
 
-    population_t NSGA2::run(criterion_t criterion) {
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    population_t NSGA2<Gen, Value, Profiler>::run(criterion_t criterion) {
         std::println("Running NSGA2 with the following parameters:");
         std::println("Individual Size: {0}", individual_size);
         std::println("Objective Size: {0}", objective_size);
@@ -164,26 +297,57 @@ namespace nsga2 {
 
         init_population(individual_size, population_size);
         size_t iter = 0;
-        fronts_t fronts;
-        while (!criterion(population, iter)) {
-            mutate(population);
-            fronts = std::move(non_dominated_sort(population));
-            population = std::move(crowding_distance_select(population, fronts));
+        while (!criterion(population.view().subview(0, population_size), iter)) {
+            generation = iter + 1;
+            mutate();
+            non_dominated_sort(population.objectives());
+            crowding_distance_select();
             iter++;
         }
-        return population;
+        return population.to_population(population_size);
     }
 
-    uint8_t NSGA2::generate_mutation_bit() {
-        mutation_attempts++;
-        if (dist(gen)) {
-            successful_mutations++;
-            return 1;
-        }
-        return 0;
-    }
-
-    double NSGA2::mutation_ratio() {
+    template <typename Gen, typename Value, profiling::profiler Profiler>
+    double NSGA2<Gen, Value, Profiler>::mutation_ratio() {
         return (double)successful_mutations / (mutation_attempts + eps);
     }
+
+    template const scores_t &crowding_distance(const objective::basic_matrix<double> &,
+                                               std::span<const index_t>, selection_buffers &);
+    template const scores_t &crowding_distance(const objective::basic_matrix<int32_t> &,
+                                               std::span<const index_t>, selection_buffers &);
+    template const scores_t &crowding_distance(const objective::basic_matrix<uint16_t> &,
+                                               std::span<const index_t>, selection_buffers &);
+    template size_t select_survivors(const objective::basic_matrix<double> &,
+                                     const sorting::sorter<double, false> &, size_t, selection_t,
+                                     selection_buffers &, profiling::none &);
+    template size_t select_survivors(const objective::basic_matrix<int32_t> &,
+                                     const sorting::sorter<int32_t, false> &, size_t, selection_t,
+                                     selection_buffers &, profiling::none &);
+    template size_t select_survivors(const objective::basic_matrix<uint16_t> &,
+                                     const sorting::sorter<uint16_t, false> &, size_t, selection_t,
+                                     selection_buffers &, profiling::none &);
+    template size_t select_survivors(const objective::basic_matrix<double> &,
+                                     const sorting::sorter<double, true> &, size_t, selection_t,
+                                     selection_buffers &, profiling::recorder &);
+    template size_t select_survivors(const objective::basic_matrix<uint16_t> &,
+                                     const sorting::sorter<uint16_t, true> &, size_t, selection_t,
+                                     selection_buffers &, profiling::recorder &);
+
+    template class NSGA2<rng::xoshiro256ss>;
+    template class NSGA2<rng::pcg64>;
+    template class NSGA2<rng::philox4x32>;
+    template class NSGA2<std::mt19937>;
+    template class NSGA2<rng::xoshiro256ss, objective::compact_val_t>;
+    template class NSGA2<rng::pcg64, objective::compact_val_t>;
+    template class NSGA2<rng::philox4x32, objective::compact_val_t>;
+    template class NSGA2<std::mt19937, objective::compact_val_t>;
+    template class NSGA2<rng::xoshiro256ss, objective::val_t, profiling::recorder>;
+    template class NSGA2<rng::pcg64, objective::val_t, profiling::recorder>;
+    template class NSGA2<rng::philox4x32, objective::val_t, profiling::recorder>;
+    template class NSGA2<std::mt19937, objective::val_t, profiling::recorder>;
+    template class NSGA2<rng::xoshiro256ss, objective::compact_val_t, profiling::recorder>;
+    template class NSGA2<rng::pcg64, objective::compact_val_t, profiling::recorder>;
+    template class NSGA2<rng::philox4x32, objective::compact_val_t, profiling::recorder>;
+    template class NSGA2<std::mt19937, objective::compact_val_t, profiling::recorder>;
 } // namespace nsga2
\ No newline at end of file
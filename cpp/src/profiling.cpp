@@ -0,0 +1,78 @@
+#include "profiling.h"
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+namespace profiling {
+
+    std::string to_string(phase p) {
+        switch (p) {
+        case phase::mutate:
+            return "mutate";
+        case phase::evaluate:
+            return "evaluate";
+        case phase::non_dominated_sort:
+            return "non_dominated_sort";
+        case phase::crowding_distance:
+            return "crowding_distance";
+        case phase::select:
+            return "crowding_distance_select";
+        }
+        throw std::invalid_argument("Unknown profiling phase");
+    }
+
+    void recorder::add_sort(std::optional<size_t> comparisons, size_t fronts) {
+        sorts++;
+        if (comparisons) {
+            counted_sorts++;
+            comparisons_ += *comparisons;
+        }
+        total_fronts += fronts;
+        last_fronts = fronts;
+    }
+
+    void recorder::add_last_front(size_t size) {
+        selections++;
+        total_last_front += size;
+        last_front_size = size;
+    }
+
+    double recorder::seconds(phase p) const {
+        clock::duration elapsed(ticks[size_t(p)].load(std::memory_order_relaxed));
+        return std::chrono::duration<double>(elapsed).count();
+    }
+
+    std::optional<size_t> recorder::comparisons() const {
+        if (counted_sorts != sorts)
+            return std::nullopt;
+        return comparisons_;
+    }
+
+    json recorder::to_json() const {
+        json out;
+        for (size_t k = 0; k < phases; k++) {
+            phase p = phase(k);
+            out["phases"][to_string(p)]["seconds"] = seconds(p);
+            out["phases"][to_string(p)]["calls"] = calls(p);
+        }
+        // null when an engine did not count its comparisons
+        std::optional<size_t> counted = comparisons();
+        out["dominance_comparisons"] = counted ? json(*counted) : json(nullptr);
+        out["fronts"]["last"] = last_fronts;
+        out["fronts"]["mean"] = sorts ? double(total_fronts) / sorts : 0.0;
+        out["last_front_size"]["last"] = last_front_size;
+        out["last_front_size"]["mean"] = selections ? double(total_last_front) / selections : 0.0;
+        return out;
+    }
+
+    void recorder::save(const std::string &filename) const {
+        std::ofstream file(filename, std::ios::trunc);
+        if (file.is_open()) {
+            file << to_json().dump(4) << std::endl;
+        } else {
+            std::cerr << "Unable to open profile file: " << filename << std::endl;
+        }
+    }
+} // namespace profiling
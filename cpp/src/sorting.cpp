@@ -0,0 +1,759 @@
+#include "sorting.h"
+#include "dominance.h"
+#include "graph.h"
+#include "individual.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace sorting {
+    using individual::word_t;
+    using individual::word_bits;
+
+    strategy parse_strategy(const std::string &name) {
+        if (name == "auto")
+            return strategy::automatic;
+        if (name == "graph")
+            return strategy::graph;
+        if (name == "deb")
+            return strategy::deb;
+        if (name == "ens-ss")
+            return strategy::ens_ss;
+        if (name == "ens-bs")
+            return strategy::ens_bs;
+        if (name == "2d")
+            return strategy::bi_objective;
+        if (name == "dc")
+            return strategy::divide_conquer;
+        throw std::invalid_argument("Unknown sorting strategy: " + name);
+    }
+
+    std::string to_string(strategy s) {
+        switch (s) {
+        case strategy::automatic:
+            return "auto";
+        case strategy::graph:
+            return "graph";
+        case strategy::deb:
+            return "deb";
+        case strategy::ens_ss:
+            return "ens-ss";
+        case strategy::ens_bs:
+            return "ens-bs";
+        case strategy::bi_objective:
+            return "2d";
+        case strategy::divide_conquer:
+            return "dc";
+        }
+        throw std::invalid_argument("Unknown sorting strategy");
+    }
+
+    template <typename T>
+    fronts_t graph_sort(const basic_matrix<T> &objectives) {
+        Graph<index_t> graph;
+        size_t size = objectives.rows();
+        // O(N) N = population size
+        for (index_t i = 0; i < size; i++)
+            graph.add_node(i);
+        // O(N^2) Is there a clever way to do this? e.g. dynamic pruning?
+        // The graph could be dense here
+        for (index_t i = 0; i < size; i++)
+            for (index_t j = 0; j < size; j++) {
+                if (pareto::strictly_dominates(objectives[i], objectives[j])) {
+                    graph.add_edge(i, j);
+                }
+            }
+        // O(N^2)
+        return graph.pop_and_get_fronts();
+    }
+
+    /**
+     * Fills the rows [begin, end) of the dominance bit matrix and their counts.
+     * Every row uses the `stride` words of scratch at `worse`, which no other
+     * thread may use at the same time.
+     */
+    template <typename T>
+    static void dominance_rows(const basic_matrix<T> &objectives,
+                               const pareto::column_block<T> &block, size_t begin, size_t end,
+                               std::vector<word_t> &dominated, std::vector<size_t> &count,
+                               word_t *worse) {
+        size_t stride = individual::words_for(block.rows());
+        for (index_t i = begin; i < end; i++) {
+            std::span<word_t> row_i(dominated.data() + i * stride, stride);
+            std::span<word_t> worse_i(worse, stride);
+            pareto::dominates_many(objectives[i], block, row_i, worse_i);
+            for (word_t word : worse_i)
+                count[i] += std::popcount(word);
+        }
+    }
+
+    template <typename T>
+    fronts_t deb_sort(const basic_matrix<T> &objectives) {
+        size_t size = objectives.rows();
+        size_t stride = individual::words_for(size);
+        // Bit (i, j) is set if i strictly dominates j
+        std::vector<word_t> dominated(size * stride, 0);
+        // Number of rows dominating each row
+        std::vector<size_t> count(size, 0);
+
+        // O(mN^2 / w): each row is compared to w rows at a time
+        std::vector<word_t> worse(stride);
+        dominance_rows(objectives, pareto::column_block<T>(objectives), 0, size, dominated, count,
+                       worse.data());
+
+        fronts_t fronts;
+        front_t current;
+        for (index_t i = 0; i < size; i++)
+            if (count[i] == 0)
+                current.push_back(i);
+
+        // O(N^2 / 64): each row of the matrix is scanned once
+        while (!current.empty()) {
+            front_t next;
+            for (index_t i : current) {
+                const word_t *row_i = dominated.data() + i * stride;
+                for (size_t w = 0; w < stride; w++) {
+                    for (word_t bits = row_i[w]; bits != 0; bits &= bits - 1) {
+                        index_t j = w * word_bits + std::countr_zero(bits);
+                        if (--count[j] == 0)
+                            next.push_back(j);
+                    }
+                }
+            }
+            // The same order as the threaded sort
+            std::sort(next.begin(), next.end());
+            fronts.push_back(std::move(current));
+            current = std::move(next);
+        }
+        return fronts;
+    }
+
+    template <typename T>
+    fronts_t deb_sort(const basic_matrix<T> &objectives, parallel::ThreadPool &pool) {
+        size_t size = objectives.rows();
+        size_t stride = individual::words_for(size);
+        // Bit (i, j) is set if i strictly dominates j
+        std::vector<word_t> dominated(size * stride, 0);
+        // Number of rows dominating each row
+        std::vector<size_t> count(size, 0);
+
+        // O(mN^2 / w) split by rows: the row i and count[i] belong to one thread
+        pareto::column_block<T> block(objectives);
+        pool.parallel_for(size, [&](size_t begin, size_t end) {
+            std::vector<word_t> worse(stride);
+            dominance_rows(objectives, block, begin, end, dominated, count, worse.data());
+        });
+
+        fronts_t fronts;
+        front_t current;
+        for (index_t i = 0; i < size; i++)
+            if (count[i] == 0)
+                current.push_back(i);
+
+        // Bit j is set when the last row dominating j has been peeled
+        std::vector<word_t> ready(stride, 0);
+        while (!current.empty()) {
+            // O(|front| N / 64) split by words of columns, which belong to one thread
+            pool.parallel_for(stride, [&](size_t begin, size_t end) {
+                for (index_t i : current) {
+                    const word_t *row_i = dominated.data() + i * stride;
+                    for (size_t w = begin; w < end; w++) {
+                        for (word_t bits = row_i[w]; bits != 0; bits &= bits - 1) {
+                            index_t j = w * word_bits + std::countr_zero(bits);
+                            if (--count[j] == 0)
+                                ready[w] |= word_t(1) << (j % word_bits);
+                        }
+                    }
+                }
+            });
+            front_t next;
+            for (size_t w = 0; w < stride; w++) {
+                for (word_t bits = ready[w]; bits != 0; bits &= bits - 1)
+                    next.push_back(w * word_bits + std::countr_zero(bits));
+                ready[w] = 0;
+            }
+            fronts.push_back(std::move(current));
+            current = std::move(next);
+        }
+        return fronts;
+    }
+
+    /* Returns `true` if some row of `front` strictly dominates the row `i`. */
+    template <typename T>
+    static bool front_dominates(const basic_matrix<T> &objectives, const front_t &front,
+                                index_t i) {
+        // The last rows added to a front are the closest to `i` in the
+        // lexicographic order, hence the most likely to dominate it
+        for (auto it = front.rbegin(); it != front.rend(); ++it) {
+            if (pareto::strictly_dominates(objectives[*it], objectives[i]))
+                return true;
+        }
+        return false;
+    }
+
+    template <typename T>
+    fronts_t ens_sort(const basic_matrix<T> &objectives, bool binary_search) {
+        size_t size = objectives.rows();
+        front_t order(size);
+        for (index_t i = 0; i < size; i++)
+            order[i] = i;
+        // O(mNlogN): decreasing lexicographic order, so that no row dominates
+        // a row placed before it. Equal rows do not dominate each other.
+        std::stable_sort(order.begin(), order.end(), [&](index_t a, index_t b) {
+            return std::ranges::lexicographical_compare(objectives[b], objectives[a]);
+        });
+
+        fronts_t fronts;
+        for (index_t i : order) {
+            // If a row is dominated by some row of the front k, it is dominated
+            // by some row of every front before k
+            size_t k;
+            if (binary_search) {
+                size_t lo = 0, hi = fronts.size();
+                while (lo < hi) {
+                    size_t mid = lo + (hi - lo) / 2;
+                    if (front_dominates(objectives, fronts[mid], i))
+                        lo = mid + 1;
+                    else
+                        hi = mid;
+                }
+                k = lo;
+            } else {
+                k = 0;
+                while (k < fronts.size() && front_dominates(objectives, fronts[k], i))
+                    k++;
+            }
+            if (k == fronts.size())
+                fronts.push_back(front_t());
+            fronts[k].push_back(i);
+        }
+        return fronts;
+    }
+
+    template <typename T>
+    fronts_t bi_objective_sort(const basic_matrix<T> &objectives) {
+        if (objectives.cols() != 2) {
+            throw std::invalid_argument("bi-objective sort requires two objectives");
+        }
+        size_t size = objectives.rows();
+        front_t order(size);
+        for (index_t i = 0; i < size; i++)
+            order[i] = i;
+        // O(NlogN): decreasing lexicographic order
+        std::stable_sort(order.begin(), order.end(), [&](index_t a, index_t b) {
+            return std::ranges::lexicographical_compare(objectives[b], objectives[a]);
+        });
+
+        fronts_t fronts;
+        for (index_t i : order) {
+            T x = objectives[i][0];
+            T y = objectives[i][1];
+            // Every row visited so far has a first objective no less than `x`,
+            // so the front k dominates row i iff its tail has a second objective
+            // no less than `y` and is not equal to row i. O(logN)
+            size_t lo = 0, hi = fronts.size();
+            while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                auto tail = objectives[fronts[mid].back()];
+                if (tail[1] >= y && (tail[0] != x || tail[1] != y))
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            if (lo == fronts.size())
+                fronts.push_back(front_t());
+            fronts[lo].push_back(i);
+        }
+        return fronts;
+    }
+
+    fronts_t fronts_from_ranks(const std::vector<size_t> &ranks) {
+        fronts_t fronts;
+        for (index_t i = 0; i < ranks.size(); i++) {
+            if (ranks[i] >= fronts.size())
+                fronts.resize(ranks[i] + 1);
+            fronts[ranks[i]].push_back(i);
+        }
+        return fronts;
+    }
+
+    namespace {
+        /**
+         * @brief The state of a divide-and-conquer sort.
+         *
+         * @details This follows the minimization convention of Jensen and
+         * Fortin: the values are the negated objectives, and since rows are
+         * distinct, a row dominates another iff it is no greater on every
+         * objective. Every set of rows is kept in increasing lexicographic order.
+         */
+        class dc_sorter {
+            using set_t = std::vector<index_t>;
+
+            const size_t m;
+            const std::vector<double> &values;
+            std::vector<size_t> &rank;
+
+            double at(index_t i, size_t k) const { return values[i * m + k]; }
+
+            /* Returns `true` if `a` is no greater than `b` on the objectives 0..k. */
+            bool weakly_dominates(index_t a, index_t b, size_t k) const {
+                for (size_t j = 0; j <= k; j++)
+                    if (at(a, j) > at(b, j))
+                        return false;
+                return true;
+            }
+
+            void update(index_t from, index_t to) { rank[to] = std::max(rank[to], rank[from] + 1); }
+
+            double median(const set_t &a, const set_t &b, size_t k) const {
+                std::vector<double> v;
+                v.reserve(a.size() + b.size());
+                for (index_t i : a)
+                    v.push_back(at(i, k));
+                for (index_t i : b)
+                    v.push_back(at(i, k));
+                std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+                return v[v.size() / 2];
+            }
+
+            /* A staircase of (second objective, rank), both strictly increasing. */
+            using stairs_t = std::map<double, size_t>;
+
+            /* The highest rank of a staircase point no greater than `y`, plus one. */
+            static size_t stairs_rank(const stairs_t &stairs, double y) {
+                auto it = stairs.upper_bound(y);
+                return it == stairs.begin() ? 0 : std::prev(it)->second + 1;
+            }
+
+            static void stairs_insert(stairs_t &stairs, double y, size_t r) {
+                auto it = stairs.upper_bound(y);
+                if (it != stairs.begin() && std::prev(it)->second >= r)
+                    return;
+                it = stairs.lower_bound(y);
+                while (it != stairs.end() && it->second <= r)
+                    it = stairs.erase(it);
+                stairs.emplace(y, r);
+            }
+
+            /* Ranks the rows of `s` on the objectives 0 and 1. */
+            void sweep_a(const set_t &s) {
+                stairs_t stairs;
+                for (index_t i : s) {
+                    rank[i] = std::max(rank[i], stairs_rank(stairs, at(i, 1)));
+                    stairs_insert(stairs, at(i, 1), rank[i]);
+                }
+            }
+
+            /* Updates the ranks of `h` from `l` on the objectives 0 and 1. */
+            void sweep_b(const set_t &l, const set_t &h) {
+                stairs_t stairs;
+                size_t li = 0;
+                for (index_t i : h) {
+                    while (li < l.size() &&
+                           (at(l[li], 0) < at(i, 0) ||
+                            (at(l[li], 0) == at(i, 0) && at(l[li], 1) <= at(i, 1)))) {
+                        stairs_insert(stairs, at(l[li], 1), rank[l[li]]);
+                        li++;
+                    }
+                    rank[i] = std::max(rank[i], stairs_rank(stairs, at(i, 1)));
+                }
+            }
+
+          public:
+            dc_sorter(size_t m, const std::vector<double> &values, std::vector<size_t> &rank)
+                : m(m), values(values), rank(rank) {}
+
+            /**
+             * @brief Ranks the rows of `s` on the objectives 0..k, knowing that
+             * they are equal on the objectives after k.
+             */
+            void helper_a(const set_t &s, size_t k) {
+                if (s.size() < 2)
+                    return;
+                if (s.size() == 2) {
+                    if (weakly_dominates(s[0], s[1], k))
+                        update(s[0], s[1]);
+                    return;
+                }
+                if (k == 0) {
+                    for (size_t i = 1; i < s.size(); i++)
+                        update(s[i - 1], s[i]);
+                    return;
+                }
+                if (k == 1) {
+                    sweep_a(s);
+                    return;
+                }
+                auto [lo, hi] = std::ranges::minmax(s, {}, [&](index_t i) { return at(i, k); });
+                if (at(lo, k) == at(hi, k)) {
+                    helper_a(s, k - 1);
+                    return;
+                }
+                // Split by the median, the rows equal to it joining the smaller
+                // side, so that the lower half is strictly below the upper half
+                double med = median(s, {}, k);
+                size_t less = 0, greater = 0;
+                for (index_t i : s) {
+                    less += at(i, k) < med;
+                    greater += at(i, k) > med;
+                }
+                bool equal_to_lower = less < greater;
+                set_t lower, upper;
+                for (index_t i : s) {
+                    if (at(i, k) < med || (at(i, k) == med && equal_to_lower))
+                        lower.push_back(i);
+                    else
+                        upper.push_back(i);
+                }
+                helper_a(lower, k);
+                helper_b(lower, upper, k - 1);
+                helper_a(upper, k);
+            }
+
+            /**
+             * @brief Updates the ranks of `h` from the final ranks of `l`,
+             * knowing that each row of `l` is strictly below each row of `h`
+             * on some objective after k.
+             */
+            void helper_b(const set_t &l, const set_t &h, size_t k) {
+                if (l.empty() || h.empty())
+                    return;
+                if (l.size() == 1 || h.size() == 1) {
+                    for (index_t j : h)
+                        for (index_t i : l)
+                            if (weakly_dominates(i, j, k))
+                                update(i, j);
+                    return;
+                }
+                if (k == 0) {
+                    size_t li = 0, best = 0;
+                    bool any = false;
+                    for (index_t j : h) {
+                        while (li < l.size() && at(l[li], 0) <= at(j, 0)) {
+                            best = std::max(best, rank[l[li]]);
+                            any = true;
+                            li++;
+                        }
+                        if (any)
+                            rank[j] = std::max(rank[j], best + 1);
+                    }
+                    return;
+                }
+                if (k == 1) {
+                    sweep_b(l, h);
+                    return;
+                }
+                auto proj = [&](index_t i) { return at(i, k); };
+                auto [l_lo, l_hi] = std::ranges::minmax(l, {}, proj);
+                auto [h_lo, h_hi] = std::ranges::minmax(h, {}, proj);
+                if (at(l_hi, k) <= at(h_lo, k)) {
+                    helper_b(l, h, k - 1);
+                    return;
+                }
+                if (at(l_lo, k) > at(h_hi, k))
+                    return;
+                // Rows of `l` above the median cannot dominate rows of `h` below
+                // it, and rows of `l` up to the median are no greater than rows of
+                // `h` from the median on objective k
+                double med = median(l, h, k);
+                set_t l_less, l_upto, l_greater, h_less, h_from, h_greater;
+                for (index_t i : l) {
+                    if (at(i, k) < med)
+                        l_less.push_back(i);
+                    else if (at(i, k) > med)
+                        l_greater.push_back(i);
+                    if (at(i, k) <= med)
+                        l_upto.push_back(i);
+                }
+                for (index_t j : h) {
+                    if (at(j, k) < med)
+                        h_less.push_back(j);
+                    else if (at(j, k) > med)
+                        h_greater.push_back(j);
+                    if (at(j, k) >= med)
+                        h_from.push_back(j);
+                }
+                helper_b(l_less, h_less, k);
+                helper_b(l_upto, h_from, k - 1);
+                helper_b(l_greater, h_greater, k);
+            }
+        };
+    } // namespace
+
+    template <typename T>
+    fronts_t divide_conquer_sort(const basic_matrix<T> &objectives) {
+        size_t size = objectives.rows();
+        size_t m = objectives.cols();
+        if (size == 0)
+            return fronts_t();
+
+        // O(mNlogN): decreasing lexicographic order, i.e. increasing order of
+        // the negated values
+        front_t order(size);
+        for (index_t i = 0; i < size; i++)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](index_t a, index_t b) {
+            return std::ranges::lexicographical_compare(objectives[b], objectives[a]);
+        });
+
+        // Merge identical rows, which never dominate each other
+        std::vector<index_t> unique_of(size);
+        std::vector<double> values;
+        size_t unique = 0;
+        for (size_t p = 0; p < size; p++) {
+            index_t i = order[p];
+            if (p == 0 || !std::ranges::equal(objectives[i], objectives[order[p - 1]])) {
+                for (double v : objectives[i])
+                    values.push_back(-v);
+                unique++;
+            }
+            unique_of[i] = unique - 1;
+        }
+
+        std::vector<size_t> unique_rank(unique, 0);
+        std::vector<index_t> all(unique);
+        for (index_t u = 0; u < unique; u++)
+            all[u] = u;
+        dc_sorter(m, values, unique_rank).helper_a(all, m - 1);
+
+        std::vector<size_t> ranks(size);
+        for (index_t i = 0; i < size; i++)
+            ranks[i] = unique_rank[unique_of[i]];
+        return fronts_from_ranks(ranks);
+    }
+
+    template <typename T>
+    fronts_t sort(const basic_matrix<T> &objectives, strategy s, parallel::ThreadPool *pool) {
+        bool threaded = pool != nullptr && pool->size() > 1;
+        switch (s) {
+        case strategy::automatic:
+            if (objectives.cols() == 2)
+                return bi_objective_sort(objectives);
+            [[fallthrough]];
+        case strategy::deb:
+            if (threaded)
+                return deb_sort(objectives, *pool);
+            return deb_sort(objectives);
+        case strategy::graph:
+            return graph_sort(objectives);
+        case strategy::ens_ss:
+            return ens_sort(objectives, false);
+        case strategy::ens_bs:
+            return ens_sort(objectives, true);
+        case strategy::bi_objective:
+            return bi_objective_sort(objectives);
+        case strategy::divide_conquer:
+            return divide_conquer_sort(objectives);
+        }
+        throw std::invalid_argument("Unknown sorting strategy");
+    }
+
+    template <typename T, bool Counting>
+    void sorter<T, Counting>::clear(size_t size) {
+        // Reserved for the largest possible number of rows and fronts, so
+        // that later sorts of the same size do not reallocate
+        order.clear();
+        order.reserve(size);
+        offsets.clear();
+        offsets.reserve(size + 1);
+        offsets.push_back(0);
+        ranks.resize(size);
+        if constexpr (Counting)
+            comparisons_.reset();
+    }
+
+    /* Ends the current front with the rows added to `order` since the last one. */
+    template <typename T, bool Counting>
+    void sorter<T, Counting>::close_front() {
+        for (size_t p = offsets.back(); p < order.size(); p++)
+            ranks[order[p]] = offsets.size() - 1;
+        offsets.push_back(order.size());
+    }
+
+    template <typename T, bool Counting>
+    void sorter<T, Counting>::deb(const basic_matrix<T> &objectives, parallel::ThreadPool *pool) {
+        size_t size = objectives.rows();
+        size_t stride = individual::words_for(size);
+        bool threaded = pool != nullptr && pool->size() > 1;
+        dominated.assign(size * stride, 0);
+        count.assign(size, 0);
+        block.assign(objectives);
+        if (threaded) {
+            // One row of scratch per thread of the pool
+            worse.resize(pool->size() * stride);
+            pool->parallel_for(size, [&](size_t begin, size_t end) {
+                word_t *scratch = worse.data() + parallel::ThreadPool::index() * stride;
+                dominance_rows(objectives, block, begin, end, dominated, count, scratch);
+            });
+        } else {
+            worse.resize(stride);
+            dominance_rows(objectives, block, 0, size, dominated, count, worse.data());
+        }
+        if constexpr (Counting)
+            comparisons_ = size * size;
+
+        for (index_t i = 0; i < size; i++)
+            if (count[i] == 0)
+                order.push_back(i);
+
+        // As `deb_sort`: each front is peeled into `order` after the previous one
+        ready.assign(stride, 0);
+        while (offsets.back() < order.size()) {
+            size_t begin = offsets.back();
+            size_t end = order.size();
+            close_front();
+            if (threaded) {
+                pool->parallel_for(stride, [&](size_t w_begin, size_t w_end) {
+                    for (size_t p = begin; p < end; p++) {
+                        const word_t *row_i = dominated.data() + order[p] * stride;
+                        for (size_t w = w_begin; w < w_end; w++) {
+                            for (word_t bits = row_i[w]; bits != 0; bits &= bits - 1) {
+                                index_t j = w * word_bits + std::countr_zero(bits);
+                                if (--count[j] == 0)
+                                    ready[w] |= word_t(1) << (j % word_bits);
+                            }
+                        }
+                    }
+                });
+                for (size_t w = 0; w < stride; w++) {
+                    for (word_t bits = ready[w]; bits != 0; bits &= bits - 1)
+                        order.push_back(w * word_bits + std::countr_zero(bits));
+                    ready[w] = 0;
+                }
+            } else {
+                for (size_t p = begin; p < end; p++) {
+                    const word_t *row_i = dominated.data() + order[p] * stride;
+                    for (size_t w = 0; w < stride; w++) {
+                        for (word_t bits = row_i[w]; bits != 0; bits &= bits - 1) {
+                            index_t j = w * word_bits + std::countr_zero(bits);
+                            if (--count[j] == 0)
+                                order.push_back(j);
+                        }
+                    }
+                }
+                std::sort(order.begin() + end, order.end());
+            }
+        }
+    }
+
+    template <typename T, bool Counting>
+    void sorter<T, Counting>::bi_objective(const basic_matrix<T> &objectives) {
+        if (objectives.cols() != 2) {
+            throw std::invalid_argument("bi-objective sort requires two objectives");
+        }
+        size_t size = objectives.rows();
+        // As `bi_objective_sort`, with ties broken by index instead of a
+        // stable sort, which allocates
+        visit.resize(size);
+        for (index_t i = 0; i < size; i++)
+            visit[i] = i;
+        std::sort(visit.begin(), visit.end(), [&](index_t a, index_t b) {
+            if (std::ranges::lexicographical_compare(objectives[b], objectives[a]))
+                return true;
+            if (std::ranges::lexicographical_compare(objectives[a], objectives[b]))
+                return false;
+            return a < b;
+        });
+
+        tails.clear();
+        tails.reserve(size);
+        size_t probes = 0;
+        for (index_t i : visit) {
+            T x = objectives[i][0];
+            T y = objectives[i][1];
+            size_t lo = 0, hi = tails.size();
+            while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                auto tail = objectives[tails[mid]];
+                if constexpr (Counting)
+                    probes++;
+                if (tail[1] >= y && (tail[0] != x || tail[1] != y))
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            if (lo == tails.size())
+                tails.push_back(i);
+            else
+                tails[lo] = i;
+            ranks[i] = lo;
+        }
+        if constexpr (Counting)
+            comparisons_ = probes;
+
+        // Counting sort of the rows by rank, in the order they were visited
+        size_t fronts = tails.size();
+        count.reserve(size + 1);
+        count.assign(fronts + 1, 0);
+        for (index_t i = 0; i < size; i++)
+            count[ranks[i] + 1]++;
+        for (size_t k = 0; k < fronts; k++) {
+            count[k + 1] += count[k];
+            offsets.push_back(count[k + 1]);
+        }
+        order.resize(size);
+        for (index_t i : visit)
+            order[count[ranks[i]]++] = i;
+    }
+
+    template <typename T, bool Counting>
+    void sorter<T, Counting>::assign(const fronts_t &fronts) {
+        for (const front_t &front : fronts) {
+            order.insert(order.end(), front.begin(), front.end());
+            close_front();
+        }
+    }
+
+    template <typename T, bool Counting>
+    void sorter<T, Counting>::sort(const basic_matrix<T> &objectives, strategy s,
+                         parallel::ThreadPool *pool) {
+        clear(objectives.rows());
+        switch (s) {
+        case strategy::automatic:
+            if (objectives.cols() == 2) {
+                bi_objective(objectives);
+                return;
+            }
+            [[fallthrough]];
+        case strategy::deb:
+            deb(objectives, pool);
+            return;
+        case strategy::bi_objective:
+            bi_objective(objectives);
+            return;
+        default:
+            assign(sorting::sort(objectives, s, pool));
+            return;
+        }
+    }
+
+    template <typename T, bool Counting>
+    fronts_t sorter<T, Counting>::fronts() const {
+        fronts_t out(size());
+        for (size_t k = 0; k < size(); k++)
+            out[k].assign((*this)[k].begin(), (*this)[k].end());
+        return out;
+    }
+
+#define SORTING_INSTANTIATE(T)                                                                     \
+    template fronts_t graph_sort(const basic_matrix<T> &);                                         \
+    template fronts_t deb_sort(const basic_matrix<T> &);                                           \
+    template fronts_t deb_sort(const basic_matrix<T> &, parallel::ThreadPool &);                   \
+    template fronts_t ens_sort(const basic_matrix<T> &, bool);                                     \
+    template fronts_t bi_objective_sort(const basic_matrix<T> &);                                  \
+    template fronts_t divide_conquer_sort(const basic_matrix<T> &);                                \
+    template fronts_t sort(const basic_matrix<T> &, strategy, parallel::ThreadPool *);             \
+    template class sorter<T, false>;                                                               \
+    template class sorter<T, true>;
+
+    SORTING_INSTANTIATE(double)
+    SORTING_INSTANTIATE(int32_t)
+    SORTING_INSTANTIATE(uint16_t)
+#undef SORTING_INSTANTIATE
+} // namespace sorting
@@ -0,0 +1,76 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+namespace parallel {
+
+    namespace {
+        thread_local size_t thread_index = 0;
+    }
+
+    ThreadPool::ThreadPool(size_t threads) {
+        for (size_t t = 1; t < std::max<size_t>(threads, 1); t++)
+            workers.emplace_back([this, t] { work(t); });
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread &worker : workers)
+            worker.join();
+    }
+
+    void ThreadPool::run_chunks() {
+        for (size_t begin = next.fetch_add(chunk); begin < n; begin = next.fetch_add(chunk))
+            (*task)(begin, std::min(begin + chunk, n));
+    }
+
+    size_t ThreadPool::index() { return thread_index; }
+
+    void ThreadPool::work(size_t index) {
+        thread_index = index;
+        size_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock lock(mutex);
+                wake.wait(lock, [&] { return stopping || epoch != seen; });
+                if (stopping)
+                    return;
+                seen = epoch;
+            }
+            run_chunks();
+            {
+                std::lock_guard lock(mutex);
+                if (--busy == 0)
+                    done.notify_one();
+            }
+        }
+    }
+
+    void ThreadPool::parallel_for(size_t n, task_t task) {
+        if (n == 0)
+            return;
+        if (workers.empty() || n == 1) {
+            task(0, n);
+            return;
+        }
+        {
+            std::lock_guard lock(mutex);
+            this->task = &task;
+            this->n = n;
+            // About 4 chunks per thread
+            chunk = std::max<size_t>(1, n / (4 * size()));
+            next.store(0);
+            busy = workers.size();
+            epoch++;
+        }
+        wake.notify_all();
+        run_chunks();
+        std::unique_lock lock(mutex);
+        done.wait(lock, [&] { return busy == 0; });
+        this->task = nullptr;
+    }
+
+} // namespace parallel
@@ -22,27 +22,27 @@ namespace end_criteria {
 
     max_iterations::max_iterations(size_t max_iterations) : max_iters(max_iterations) {}
 
-    bool max_iterations::operator()(const population_t &population, const size_t iteration) {
+    bool max_iterations::operator()(const population_view &population, const size_t iteration) {
         return iteration >= max_iters;
     }
 
     cover_mlotz_pareto_front::cover_mlotz_pareto_front(size_t m) : m(m) {}
 
-    size_t count_pareto_front(const population_t &p, size_t m) {
+    size_t count_pareto_front(const population_view &p, size_t m) {
         size_t count_pareto_front = 0;
-        for (const auto &individual : p)
-            if (benchmark::is_mlotz_pareto_front(m, individual))
+        for (individual::genome_view individual : p)
+            if (benchmark::words::is_mlotz_pareto_front(m, individual))
                 count_pareto_front++;
         return count_pareto_front;
     }
 
-    bool cover_mlotz_pareto_front::operator()(const population_t &p, const size_t iter) {
+    bool cover_mlotz_pareto_front::operator()(const population_view &p, const size_t iter) {
         using individual::operator<<;
         size_t cnt = count_pareto_front(p, m);
         if (iter % 20 == 0)
             std::println("Iteration: {0}, individuals on Pareto front: {1}", iter, cnt);
         if (cnt == p.size()) {
-            for (auto &i : p) {
+            for (auto i : p) {
                 std::cout << "individual: " << i << std::endl;
             }
             return true;
@@ -54,50 +54,77 @@ namespace end_criteria {
     // size_t print_period, std::string filename);
     Task6Logger::Task6Logger(const size_t id, const size_t p, const size_t m,
                              const size_t max_iters, const std::string filename,
-                             const size_t print_period)
-        : id(id), p(p), m(m), max_iters(max_iters), print_period(print_period), filename(filename) {
-        log_data["metadata"]["begin_time"] = get_current_time();
-        log_data["metadata"]["individual_size"] = id;
-        log_data["metadata"]["population_size"] = p;
-        log_data["metadata"]["objective_size"] = m;
-        log_data["metadata"]["max_iters"] = max_iters;
-        log_data["count_pareto_front"] = json::array();
-        log_data["final_population"] = json::array();
+                             const size_t print_period, const size_t flush_period)
+        : id(id), p(p), m(m), max_iters(max_iters), print_period(print_period),
+          flush_period(flush_period), filename(filename) {
+        // A new log starts with its metadata
+        std::ofstream log_file(filename, std::ios::trunc);
+        if (!log_file.is_open()) {
+            std::cerr << "Unable to open log file: " << filename << std::endl;
+            return;
+        }
+        json metadata;
+        metadata["type"] = "metadata";
+        metadata["begin_time"] = get_current_time();
+        metadata["individual_size"] = id;
+        metadata["population_size"] = p;
+        metadata["objective_size"] = m;
+        metadata["max_iters"] = max_iters;
+        log_file << metadata.dump() << '\n';
     }
 
-    void Task6Logger::sync_to_file() {
-        std::ofstream log_file(filename, std::ios::trunc);
+    Task6Logger::~Task6Logger() { flush(); }
+
+    void Task6Logger::append(const json &record) {
+        pending += record.dump();
+        pending += '\n';
+        pending_records++;
+    }
+
+    void Task6Logger::flush() {
+        if (pending_records == 0)
+            return;
+        // Whole lines are appended, and the file is closed after each batch
+        std::ofstream log_file(filename, std::ios::app);
         if (log_file.is_open()) {
-            log_file << log_data.dump(4) << std::endl;
-            log_file.close();
+            log_file << pending << std::flush;
         } else {
             std::cerr << "Unable to open log file: " << filename << std::endl;
         }
+        pending.clear();
+        pending_records = 0;
     }
 
     void Task6Logger::log_new_data(size_t optimum_count, const size_t current_iter) {
-        log_data["count_pareto_front"].push_back(optimum_count);
+        append({{"type", "generation"},
+                {"iteration", current_iter},
+                {"count_pareto_front", optimum_count}});
+        if (pending_records >= flush_period)
+            flush();
         if (current_iter % print_period == 0) {
             std::println("Iteration: {0}, individuals on Pareto front: {1}",
                          current_iter,
                          optimum_count);
-            sync_to_file();
         }
     }
 
-    void Task6Logger::add_final_results(const population_t &population) {
+    void Task6Logger::add_final_results(const population_view &population) {
         using individual::operator<<;
-        for (const individual_t &individual : population) {
+        json record;
+        record["type"] = "final_population";
+        record["end_time"] = get_current_time();
+        record["final_population"] = json::array();
+        for (individual::genome_view individual : population) {
             auto result = individual::to_string(individual);
             if (!result.empty() && result[result.size() - 1] == '\n')
                 result.erase(result.size() - 1);
-            log_data["final_population"].push_back(result);
+            record["final_population"].push_back(result);
         }
-        log_data["metadata"]["end_time"] = get_current_time();
+        append(record);
         std::println("Saving log to {0}", filename);
     }
 
-    bool Task6Logger::operator()(const population_t &population, const size_t current_iter) {
+    bool Task6Logger::operator()(const population_view &population, const size_t current_iter) {
 
         // Count the number of individuals in the Pareto set
         size_t cnt = count_pareto_front(population, m);
@@ -110,7 +137,7 @@ namespace end_criteria {
 
             // save final results
             add_final_results(population);
-            sync_to_file();
+            flush();
             return true;
         }
         return false;
@@ -0,0 +1,133 @@
+#include "benchmark.h"
+#include "evaluation.h"
+#include "nsga2.h"
+#include "rng.h"
+#include "sorting.h"
+#include "static_nsga2.h"
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <print>
+#include <span>
+
+// Every heap allocation of the program goes through these
+static std::atomic<size_t> allocations = 0;
+
+void *operator new(size_t size) {
+    allocations++;
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void *operator new[](size_t size) { return operator new(size); }
+void *operator new(size_t size, std::align_val_t align) {
+    allocations++;
+    size_t alignment = static_cast<size_t>(align);
+    // aligned_alloc takes a multiple of the alignment
+    if (void *p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment))
+        return p;
+    throw std::bad_alloc();
+}
+void *operator new[](size_t size, std::align_val_t align) { return operator new(size, align); }
+
+// Every deallocation goes through this one, the memory of both the plain and
+// the aligned `new` being released by `std::free`. Once it is inlined, GCC
+// sees `free` called on the result of `operator new` without knowing that
+// both are replaced above and use malloc, a false positive.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void *p) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+void operator delete[](void *p) noexcept { operator delete(p); }
+void operator delete(void *p, size_t) noexcept { operator delete(p); }
+void operator delete[](void *p, size_t) noexcept { operator delete(p); }
+void operator delete(void *p, std::align_val_t) noexcept { operator delete(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { operator delete(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { operator delete(p); }
+void operator delete[](void *p, size_t, std::align_val_t) noexcept { operator delete(p); }
+
+/**
+ * Runs `experiment` for `iterations` generations and returns the number of
+ * allocations made by the generations after the first `warmup` ones.
+ */
+template <typename Experiment>
+size_t steady_allocations(Experiment &experiment, size_t warmup, size_t iterations) {
+    size_t before = 0, after = 0;
+    end_criteria::criterion_t criterion = [&](const individual::population_view &, size_t iter) {
+        if (iter == warmup)
+            before = allocations;
+        if (iter == iterations)
+            after = allocations;
+        return iter >= iterations;
+    };
+    experiment.run(criterion);
+    return after - before;
+}
+
+/* mLOTZ evaluated in batches only, without `evaluate_delta`. */
+struct batch_mlotz {
+    benchmark::mlotz_functor f;
+
+    size_t objectives() const { return f.objectives(); }
+
+    template <typename T>
+    void evaluate(individual::population_view genomes, std::span<T> values) const {
+        f.evaluate(genomes, values);
+    }
+};
+
+/* The generation loop allocates nothing once its arenas are built. */
+template <typename Gen, typename Value>
+void test_steady_state(size_t n, size_t m, size_t N, sorting::strategy strategy,
+                       size_t threads, bool delta) {
+    using T = typename Value::value_type;
+    auto f = delta ? objective::make_batch_objective<T>(benchmark::mlotz_functor(m))
+                   : objective::make_batch_objective<T>(batch_mlotz{benchmark::mlotz_functor(m)});
+    nsga2::NSGA2<Gen, Value> experiment(n, m, N, f, 5);
+    experiment.set_sort_strategy(strategy);
+    experiment.set_threads(threads);
+    size_t count = steady_allocations(experiment, 3, 40);
+    std::println("n = {0}, m = {1}, N = {2}, {3} threads, {4}: {5} allocations", n, m, N,
+                 threads, sorting::to_string(strategy), count);
+    assert(count == 0);
+}
+
+/* The same for the static path. */
+template <size_t N, size_t M>
+void test_static_steady_state(size_t population_size, sorting::strategy strategy,
+                              size_t threads) {
+    nsga2::StaticNSGA2<N, M, benchmark::static_mlotz<N, M>> experiment(
+        population_size, benchmark::static_mlotz<N, M>(), 5);
+    experiment.set_sort_strategy(strategy);
+    experiment.set_threads(threads);
+    size_t count = steady_allocations(experiment, 3, 40);
+    std::println("static n = {0}, m = {1}, N = {2}, {3} threads, {4}: {5} allocations", N, M,
+                 population_size, threads, sorting::to_string(strategy), count);
+    assert(count == 0);
+}
+
+int main() {
+    using sorting::strategy;
+    using objective::compact_val_t;
+    using objective::val_t;
+
+    // Delta evaluation, Deb's sort on one and several threads
+    test_steady_state<rng::xoshiro256ss, compact_val_t>(32, 4, 50, strategy::automatic, 1, true);
+    test_steady_state<rng::xoshiro256ss, compact_val_t>(32, 4, 50, strategy::deb, 3, true);
+    test_steady_state<rng::philox4x32, val_t>(100, 8, 40, strategy::deb, 2, true);
+    // Bi-objective sort
+    test_steady_state<rng::pcg64, val_t>(40, 2, 30, strategy::automatic, 1, true);
+    // Batch evaluation without delta
+    test_steady_state<rng::xoshiro256ss, compact_val_t>(24, 4, 30, strategy::automatic, 2,
+                                                        false);
+    // The static path, Deb's and the bi-objective sort
+    test_static_steady_state<32, 4>(50, strategy::automatic, 1);
+    test_static_steady_state<48, 8>(40, strategy::deb, 3);
+    test_static_steady_state<20, 2>(30, strategy::automatic, 2);
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include "benchmark.h"
 #include "individual.h"
+#include "rng.h"
 #include <cassert>
 #include <iostream>
 
@@ -53,8 +54,68 @@ void test_pareto_front() {
     return;
 }
 
+/* The word-level kernels agree with the gene-by-gene functions. */
+void test_words() {
+    rng::xoshiro256ss gen(11);
+    // Slices shorter than, equal to and longer than a word, unaligned
+    const size_t sizes[] = {6, 12, 64, 96, 130, 200, 256};
+    const int ms[] = {2, 4, 8};
+    for (size_t n : sizes) {
+        for (int m : ms) {
+            if (n % (m / 2) != 0)
+                continue;
+            size_t len = 2 * n / m;
+            for (int trial = 0; trial < 200; trial++) {
+                individual_t x(n);
+                if (trial % 4 == 0) {
+                    // A point of the front: ones then zeros in each slice
+                    for (size_t s = 0; s < n; s += len) {
+                        size_t ones = gen() % (len + 1);
+                        for (size_t i = 0; i < ones; i++)
+                            x.set(s + i);
+                    }
+                } else {
+                    rng::fill(gen, x.words());
+                    x.trim();
+                    // Long runs of ones or zeros at the ends of random slices
+                    size_t s = (gen() % (m / 2)) * len;
+                    size_t run = gen() % (len + 1);
+                    for (size_t i = 0; i < run; i++) {
+                        if (trial % 2)
+                            x.set(s + i, true);
+                        else
+                            x.set(s + len - 1 - i, false);
+                    }
+                }
+                assert(words::mlotz(m, x) == mlotz(m, x));
+                assert(words::is_mlotz_pareto_front(m, x) == is_mlotz_pareto_front(m, x));
+                for (int k = 0; k < m; k++)
+                    assert(words::mlotzk(m, k, x) == mlotzk(m, k, x));
+                assert(words::lotzk(0, x) == lotzk(0, x));
+                assert(words::lotzk(1, x) == lotzk(1, x));
+            }
+        }
+    }
+    // Every sub-view of a genome spanning several words
+    individual_t y(150);
+    rng::fill(gen, y.words());
+    y.trim();
+    for (size_t i = 0; i < 40; i++)
+        y.set(20 + i, true);
+    for (size_t i = 0; i < 50; i++)
+        y.set(90 + i, false);
+    for (size_t offset = 0; offset < y.size(); offset += 7) {
+        for (size_t count = 1; offset + count <= y.size(); count += 5) {
+            span v = y.view().subspan(offset, count);
+            assert(words::lotzk(0, v) == lotzk(0, v));
+            assert(words::lotzk(1, v) == lotzk(1, v));
+        }
+    }
+}
+
 int main() {
     test_mlotz();
     test_pareto_front();
+    test_words();
     return 0;
 }
\ No newline at end of file
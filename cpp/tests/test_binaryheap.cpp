@@ -1,11 +1,65 @@
 #include "binaryheap.h"
+#include <algorithm>
 #include <cassert>
 #include <print>
+#include <random>
 
 using namespace binary_heap;
 
+/* Checks that `Heap` extracts randomly inserted and updated keys in order. */
+template <typename Heap>
+void test_random_keys(Heap queue) {
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    std::vector<double> keys(200);
+    for (int i = 0; i < (int)keys.size(); ++i) {
+        keys[i] = dist(gen);
+        queue.emplace(Node{.key = keys[i], .id = i});
+    }
+    // Move some keys in both directions
+    for (int i = 0; i < (int)keys.size(); i += 3) {
+        double key = dist(gen);
+        if (key < keys[i])
+            queue.decrease_key(i, key);
+        else
+            queue.increase_key(i, key);
+        keys[i] = key;
+    }
+    std::vector<double> expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<double> ordered;
+    while (queue.size() > 0) {
+        Node<double, int> node = queue.extract_min();
+        assert(node.key == keys[node.id]);
+        assert(!queue.contains(node.id));
+        ordered.push_back(node.key);
+    }
+    assert(ordered == expected);
+}
+
+void test_basic_heap() {
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    BasicBinaryHeap<double> basic;
+    for (int i = 0; i < 200; ++i) {
+        basic.emplace(dist(gen));
+    }
+    double last = -1.0;
+    while (basic.size() > 0) {
+        double key = basic.extract_min();
+        assert(key >= last);
+        last = key;
+    }
+}
 
 int main() {
+    test_basic_heap();
+    test_random_keys(BinaryHeap<double, int>());
+    test_random_keys(DenseHeap<double, int>());
+    test_random_keys(DenseHeap<double, int, 4>(200));
 
     BinaryHeap<double, int> queue{};
 
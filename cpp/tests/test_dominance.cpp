@@ -0,0 +1,67 @@
+#include "dominance.h"
+#include "individual.h"
+#include <cassert>
+#include <print>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using individual::word_t;
+
+/* Random objective values among `levels` values spread over the range of `T`. */
+template <typename T>
+objective::basic_matrix<T> random_objectives(size_t n, size_t m, int levels, std::mt19937 &gen) {
+    // Signed values and unsigned values with the top bit set are covered
+    std::uniform_int_distribution<int> dist(0, levels - 1);
+    T low = std::is_signed_v<T> ? T(-20000) : T(0);
+    objective::basic_matrix<T> objectives(n, m);
+    for (size_t i = 0; i < n; i++)
+        for (size_t k = 0; k < m; k++)
+            objectives.row(i)[k] = low + T(dist(gen) * 20000);
+    return objectives;
+}
+
+/* Every kernel agrees with pareto::compare on every pair. */
+template <typename T>
+void test_kernels_agree_with_compare(const char *type) {
+    std::mt19937 gen(42);
+    for (auto k : {pareto::kernel::scalar, pareto::kernel::avx2, pareto::kernel::avx512}) {
+        if (!pareto::supported(k)) {
+            std::println("{0}: not supported, skipped", pareto::to_string(k));
+            continue;
+        }
+        for (size_t m : {1, 2, 3, 4, 8, 11}) {
+            for (size_t n : {0, 1, 3, 8, 63, 64, 65, 130}) {
+                auto objectives = random_objectives<T>(n, m, 3, gen);
+                pareto::column_block block(objectives);
+                size_t words = individual::words_for(n);
+                std::vector<word_t> better(words, ~word_t(0)), worse(words, ~word_t(0));
+                for (size_t i = 0; i < n; i++) {
+                    pareto::dominates_many(k, objectives[i], block, better, worse);
+                    for (size_t j = 0; j < n; j++) {
+                        pareto::order cmp = pareto::compare(objectives[i], objectives[j]);
+                        bool b = (better[j / 64] >> (j % 64)) & 1;
+                        bool w = (worse[j / 64] >> (j % 64)) & 1;
+                        assert(b == (cmp > 0));
+                        assert(w == (cmp < 0));
+                    }
+                    // No bit past the last row
+                    if (n % 64 != 0) {
+                        assert(better.back() >> (n % 64) == 0);
+                        assert(worse.back() >> (n % 64) == 0);
+                    }
+                }
+            }
+        }
+        std::println("{0} {1}: agrees with pareto::compare", pareto::to_string(k), type);
+    }
+}
+
+int main() {
+    std::println("Best kernel: {0}", pareto::to_string(pareto::best_kernel()));
+    test_kernels_agree_with_compare<double>("double");
+    test_kernels_agree_with_compare<int32_t>("int32_t");
+    test_kernels_agree_with_compare<uint16_t>("uint16_t");
+    std::println("Success");
+    return 0;
+}
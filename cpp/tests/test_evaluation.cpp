@@ -0,0 +1,161 @@
+#include "benchmark.h"
+#include "evaluation.h"
+#include "individual.h"
+#include "mutation.h"
+#include "population.h"
+#include "rng.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using individual::individual_t;
+using individual::population_t;
+
+/* A view of the single genome `x`. */
+individual::population_view single(const individual_t &x) {
+    return individual::population_view(x.words().data(), 1, x.size(), x.words().size());
+}
+
+template <typename T>
+void test_batch(const population_t &population, size_t m) {
+    benchmark::mlotz_functor f(m);
+    static_assert(objective::batch_evaluator<benchmark::mlotz_functor, T>);
+
+    // The genomes stored contiguously, read in place
+    individual::basic_population<T> store(population, m);
+    individual::population_view genomes = store.view();
+
+    // Static dispatch, the whole population at once
+    objective::basic_matrix<T> direct(population.size(), m);
+    f.evaluate(genomes, direct.row_range(0, population.size()));
+
+    // One virtual call per batch, in batches of 5 rows
+    auto batched = objective::make_batch_objective<T>(f);
+    assert(batched->objectives() == m);
+    objective::basic_matrix<T> virtual_(population.size(), m);
+    for (size_t first = 0; first < population.size(); first += 5) {
+        size_t count = std::min<size_t>(5, population.size() - first);
+        batched->evaluate(genomes.subview(first, count), virtual_.row_range(first, count));
+    }
+
+    // One call per genome
+    objective::function_objective<T, objective::val_t> per_genome(f, m);
+    objective::basic_matrix<T> legacy(population.size(), m);
+    per_genome.evaluate(genomes, legacy.row_range(0, population.size()));
+
+    for (size_t i = 0; i < population.size(); i++) {
+        objective::val_t expected = benchmark::mlotz(m, population[i]);
+        for (size_t k = 0; k < m; k++) {
+            assert(direct[i][k] == static_cast<T>(expected[k]));
+            assert(virtual_[i][k] == direct[i][k]);
+            assert(legacy[i][k] == direct[i][k]);
+        }
+    }
+}
+
+/* `evaluate_delta` agrees with `evaluate` on mutated children. */
+template <typename T>
+void test_delta(size_t n, size_t m, double rate) {
+    benchmark::mlotz_functor f(m);
+    static_assert(objective::delta_evaluator<benchmark::mlotz_functor, T>);
+    auto batched = objective::make_batch_objective<T>(f);
+    assert(batched->has_delta());
+    objective::function_objective<T, objective::val_t> per_genome(f, m);
+    assert(!per_genome.has_delta());
+
+    rng::xoshiro256ss gen(9);
+    mutation::bitwise mutate(rate);
+    individual_t parent(n);
+    std::vector<T> parent_value(m), value(m), expected(m);
+    std::vector<size_t> flipped;
+    for (size_t t = 0; t < 2000; t++) {
+        // Mostly points near the front, where runs are long
+        if (t % 100 == 0) {
+            rng::fill(gen, parent.words());
+            parent.trim();
+        }
+        f.evaluate(single(parent), std::span<T>(parent_value));
+        individual_t child = parent;
+        flipped.clear();
+        mutate(child, gen, flipped);
+        batched->evaluate_delta(child, parent_value, flipped, value);
+        f.evaluate(single(child), std::span<T>(expected));
+        assert(value == expected);
+        parent = child;
+    }
+}
+
+/* Values beyond the range of `T` are rejected rather than wrapped. */
+void test_overflow() {
+    // With m = 2, the all-ones genome has a leading-ones value of n = 65536
+    const size_t n = 65536, m = 2;
+    benchmark::mlotz_functor f(m);
+    individual_t x(n);
+    for (size_t i = 0; i < n; i++)
+        x.set(i, true);
+
+    std::vector<int32_t> wide(m);
+    f.evaluate(single(x), std::span<int32_t>(wide));
+    assert(wide[0] == static_cast<int32_t>(n));
+
+    std::vector<uint16_t> value(m), parent(m);
+    bool threw = false;
+    try {
+        f.evaluate(single(x), std::span<uint16_t>(value));
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::vector<size_t> flipped = {0};
+    threw = false;
+    try {
+        f.evaluate_delta(x, std::span<const uint16_t>(parent), flipped,
+                         std::span<uint16_t>(value));
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    assert(threw);
+
+    // The same for the compact values returned per genome
+    assert(benchmark::basic_mlotz_functor<objective::val_t>(m)(x)[0] == n);
+    benchmark::basic_mlotz_functor<objective::compact_val_t> compact(m);
+    threw = false;
+    try {
+        compact(x);
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+int main() {
+    const size_t n = 24, m = 4;
+    rng::xoshiro256ss gen(3);
+    population_t population(23, individual_t(n));
+    for (individual_t &x : population) {
+        rng::fill(gen, x.words());
+        x.trim();
+    }
+    // All zeros and all ones
+    population[0] = individual_t(n, 0);
+    for (size_t i = 0; i < n; i++)
+        population[1].set(i, true);
+
+    test_batch<double>(population, m);
+    test_batch<int32_t>(population, m);
+    test_batch<uint16_t>(population, m);
+
+    test_delta<double>(24, 4, 1.0 / 24);
+    test_delta<uint16_t>(200, 8, 1.0 / 200);
+    test_delta<int32_t>(130, 2, 0.25);
+
+    test_overflow();
+
+    std::println("All tests passed");
+    return 0;
+}
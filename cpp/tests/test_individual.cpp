@@ -1,7 +1,9 @@
 #include "individual.h"
 #include "utils.h"
+#include <array>
 #include <cassert>
 #include <iostream>
+#include <stdexcept>
 
 using individual::individual_t;
 using objective::val_t;
@@ -14,7 +16,116 @@ val_t f(const individual_t &x) {
     return v;
 }
 
+void test_packed_genome() {
+    using namespace individual;
+
+    // Spans several words with a partial last word
+    const size_t n = 130;
+    bytes_t bytes(n);
+    for (size_t i = 0; i < n; ++i) {
+        bytes[i] = (i % 3 == 0) || (i > 100 && i % 7 == 0);
+    }
+    individual_t a = from_bytes(bytes);
+    assert(a.size() == n);
+    assert(a.words().size() == 3);
+    assert(to_bytes(a) == bytes);
+
+    individual_t b(n);
+    for (size_t i = 0; i < n; i += 2) {
+        b.set(i);
+    }
+
+    bytes_t and_bytes(n), or_bytes(n), xor_bytes(n), not_bytes(n);
+    for (size_t i = 0; i < n; ++i) {
+        and_bytes[i] = bytes[i] & (i % 2 == 0);
+        or_bytes[i] = bytes[i] | (i % 2 == 0);
+        xor_bytes[i] = bytes[i] ^ (i % 2 == 0);
+        not_bytes[i] = !bytes[i];
+    }
+    assert(to_bytes(a & b) == and_bytes);
+    assert(to_bytes(a | b) == or_bytes);
+    assert(to_bytes(a ^ b) == xor_bytes);
+    assert(to_bytes(~a) == not_bytes);
+    // The padding bits of the last word stay cleared
+    assert((~a).count() == n - a.count());
+    assert(~~a == a);
+
+    individual_t c = a;
+    c ^= a;
+    assert(c == individual_t(n));
+    c |= b;
+    assert(c == b);
+    c &= a;
+    assert(c == (a & b));
+
+    // Unaligned sub-views
+    span v = span(a).subspan(60, 10);
+    for (size_t i = 0; i < v.size(); ++i) {
+        assert(v[i] == (bool)bytes[60 + i]);
+    }
+
+    a.flip(5);
+    assert(a[5] != (bool)bytes[5]);
+}
+
+/* The owning, static and borrowed genomes share their gene operations. */
+void test_genome_kinds() {
+    using namespace individual;
+
+    const size_t n = 70;
+    genome a(n);
+    static_genome<n> b;
+    std::array<word_t, words_for(n)> words{};
+    genome_ref c(words.data(), n);
+    for (size_t i = 0; i < n; i += 3) {
+        a.set(i);
+        b.set(i);
+        c.set(i);
+    }
+    a.flip();
+    b.flip();
+    c.flip();
+    assert(a.count() == n - 24 && b.count() == a.count() && c.count() == a.count());
+    assert(b.to_genome() == a);
+    // Flipping cleared the padding bits of the last word
+    assert(words[1] == a.words()[1] && words[1] >> (n % word_bits) == 0);
+    for (size_t i = 0; i < n; ++i)
+        assert(a.test(i) == (i % 3 != 0) && b[i] == a[i] && c[i] == a[i]);
+}
+
+void test_compact_values() {
+    using objective::compact_val_t;
+
+    compact_val_t a = {3, 1, 65535};
+    compact_val_t b(3, 1);
+    b[2] = 65535;
+    assert(a.size() == 3 && b.size() == 3);
+    assert(!(a == b));
+    b[0] = 3;
+    assert(a == b);
+
+    bool threw = false;
+    try {
+        compact_val_t too_long(compact_val_t::capacity() + 1);
+    } catch (const std::length_error &) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Rows of an integer matrix compare exactly
+    objective::basic_matrix<uint16_t> values(2, 3);
+    values.assign(0, a);
+    values.assign(1, {3, 0, 65535});
+    assert(pareto::compare(values[0], values[1]) > 0);
+    assert(pareto::strictly_dominates(values[0], values[1]));
+    assert(pareto::compare(values[0], values[0]) == 0);
+}
+
 int main() {
+    test_packed_genome();
+    test_genome_kinds();
+    test_compact_values();
+
     individual_t x = {1, 0, 1};
     individual_t y = {1, 1, 1};
     individual_t z = {1, 1, 0};
@@ -0,0 +1,76 @@
+#include "individual.h"
+#include "modified_nsga2.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <print>
+#include <random>
+
+using modified_nsga2::front_t;
+using objective::matrix_t;
+
+/* Truncate the front by recomputing every crowding distance after each removal. */
+front_t naive_select(const matrix_t &objectives, front_t front, size_t keep) {
+    const double eps = 1e-8;
+    const double inf = std::numeric_limits<double>::infinity();
+    size_t m = objectives.cols();
+    std::vector<double> range(m);
+    for (size_t k = 0; k < m; k++) {
+        auto [lo, hi] = std::ranges::minmax(front, {}, [&](size_t i) { return objectives[i][k]; });
+        range[k] = objectives[hi][k] - objectives[lo][k] + eps;
+    }
+    while (front.size() > keep) {
+        std::vector<double> distances(front.size(), 0.0);
+        std::vector<size_t> order(front.size());
+        for (size_t k = 0; k < m; k++) {
+            for (size_t p = 0; p < front.size(); p++)
+                order[p] = p;
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+                return objectives[front[a]][k] < objectives[front[b]][k];
+            });
+            distances[order.front()] = inf;
+            distances[order.back()] = inf;
+            for (size_t j = 1; j + 1 < order.size(); j++) {
+                distances[order[j]] += (objectives[front[order[j + 1]]][k] -
+                                        objectives[front[order[j - 1]]][k]) /
+                                       range[k];
+            }
+        }
+        size_t worst = std::min_element(distances.begin(), distances.end()) - distances.begin();
+        front.erase(front.begin() + worst);
+    }
+    return front;
+}
+
+int main() {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    for (size_t m : {2, 3, 5}) {
+        for (size_t size : {2, 10, 50}) {
+            matrix_t objectives(size + 5, m);
+            for (size_t i = 0; i < objectives.rows(); i++)
+                for (size_t k = 0; k < m; k++)
+                    objectives.row(i)[k] = dist(gen);
+            // A front made of some rows of the population
+            front_t front;
+            for (size_t i = 0; i < size; i++)
+                front.push_back(i + 5);
+
+            for (size_t keep : {size, size / 2 + 2 * m, size / 2}) {
+                // With at least 2m survivors, every removed individual has a
+                // finite distance, so there are no ties to break
+                if (keep > size || keep < 2 * m)
+                    continue;
+                front_t kept = modified_nsga2::dynamic_crowding_select(objectives, front, keep);
+                front_t expected = naive_select(objectives, front, keep);
+                std::sort(kept.begin(), kept.end());
+                std::sort(expected.begin(), expected.end());
+                assert(kept.size() == keep);
+                assert(kept == expected);
+            }
+        }
+        std::println("m = {0}: dynamic selection matches the naive selection", m);
+    }
+    return 0;
+}
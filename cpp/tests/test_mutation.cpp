@@ -0,0 +1,87 @@
+#include "individual.h"
+#include "mutation.h"
+#include <cassert>
+#include <cmath>
+#include <print>
+#include <random>
+#include <vector>
+
+using individual::individual_t;
+
+/* The skip-sampled mutation flips each gene independently with the given rate. */
+void test_distribution(size_t n, double rate) {
+    std::mt19937 gen(7);
+    mutation::bitwise mutate(rate);
+    const size_t trials = 20000;
+
+    std::vector<size_t> flips_at(n, 0);
+    size_t total_flips = 0;
+    size_t no_flip = 0;
+    for (size_t t = 0; t < trials; t++) {
+        individual_t x(n);
+        size_t flips = mutate(x, gen);
+        assert(flips == x.count());
+        total_flips += flips;
+        no_flip += flips == 0;
+        for (size_t j = 0; j < n; j++)
+            flips_at[j] += x[j];
+    }
+
+    // Each gene flips with probability `rate`: check every position within
+    // 5 standard deviations
+    double mean = trials * rate;
+    double sd = std::sqrt(trials * rate * (1 - rate));
+    for (size_t j = 0; j < n; j++)
+        assert(std::abs(flips_at[j] - mean) < 5 * sd);
+
+    // The number of flips is Binomial(n, rate)
+    double expected_flips = trials * n * rate;
+    assert(std::abs(total_flips - expected_flips) < 5 * std::sqrt(expected_flips));
+    double expected_no_flip = trials * std::pow(1 - rate, n);
+    assert(std::abs(no_flip - expected_no_flip) <
+           5 * std::sqrt(expected_no_flip * (1 - std::pow(1 - rate, n))) + 1);
+    std::println("n = {0}, rate = {1}: {2} flips per offspring", n, rate,
+                 (double)total_flips / trials);
+}
+
+void test_edge_rates() {
+    std::mt19937 gen(0);
+    individual_t x(70);
+    assert(mutation::bitwise(0.0)(x, gen) == 0);
+    assert(x.count() == 0);
+    assert(mutation::bitwise(1.0)(x, gen) == 70);
+    assert(x.count() == 70);
+}
+
+/* Recording the flipped genes changes neither the draws nor the offspring. */
+void test_flipped_positions(size_t n, double rate) {
+    std::mt19937 a(5), b(5);
+    mutation::bitwise plain(rate), recording(rate);
+    for (size_t t = 0; t < 200; t++) {
+        individual_t x(n), y(n);
+        std::vector<size_t> flipped;
+        size_t flips = plain(x, a);
+        assert(recording(y, b, flipped) == flips);
+        assert(x == y);
+        assert(flipped.size() == flips);
+        for (size_t i = 0; i < flipped.size(); i++) {
+            assert(y[flipped[i]]);
+            assert(i == 0 || flipped[i - 1] < flipped[i]);
+        }
+    }
+}
+
+int main() {
+    // Skip sampling
+    test_distribution(10, 0.1);
+    test_distribution(100, 0.01);
+    test_distribution(130, 0.3);
+    // Masks built from random words
+    test_distribution(10, 0.5);
+    test_distribution(130, 0.125);
+    test_edge_rates();
+    test_flipped_positions(100, 0.01);
+    test_flipped_positions(130, 0.25);
+    test_flipped_positions(70, 1.0);
+    return 0;
+}
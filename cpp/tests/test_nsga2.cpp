@@ -1,4 +1,5 @@
 #include "benchmark.h"
+#include "evaluation.h"
 #include "nsga2.h"
 #include <cstdint>
 #include <print>
@@ -25,5 +26,26 @@ int main() {
     std::println("Population size: {0}", pop.size());
     assert(pop.size() == population_size);
 
+    // The same seed gives the same run, whatever the number of threads
+    end_criteria::criterion_t fixed = end_criteria::max_iterations(max_iters);
+    auto a = nsga2::NSGA2<rng::philox4x32>(individual_size, objective_size, population_size, f, 7);
+    auto b = nsga2::NSGA2<rng::philox4x32>(individual_size, objective_size, population_size, f, 7);
+    b.set_threads(4);
+    population_t reference = a.run(fixed);
+    assert(b.run(fixed) == reference);
+
+    // Compact integer values select the same individuals as doubles
+    auto compact = nsga2::NSGA2<rng::philox4x32, objective::compact_val_t>(
+        individual_size, objective_size, population_size,
+        benchmark::basic_mlotz_functor<objective::compact_val_t>(objective_size), 7);
+    assert(compact.run(fixed) == reference);
+
+    // Batch evaluation gives the same run as one call per genome
+    auto batched = nsga2::NSGA2<rng::philox4x32>(
+        individual_size, objective_size, population_size,
+        objective::make_batch_objective<double>(mlotz_functor(objective_size)), 7);
+    batched.set_threads(3);
+    assert(batched.run(fixed) == reference);
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "individual.h"
+#include "population.h"
+#include "rng.h"
+#include "utils.h"
+#include <cassert>
+#include <cstdint>
+#include <print>
+#include <vector>
+
+using individual::individual_t;
+using individual::population_t;
+
+population_t random_population(size_t size, size_t n, uint64_t seed) {
+    rng::xoshiro256ss gen(seed);
+    population_t population(size, individual_t(n));
+    for (individual_t &x : population) {
+        rng::fill(gen, x.words());
+        x.trim();
+    }
+    return population;
+}
+
+/* The genomes are stored at a fixed stride and read back unchanged. */
+void test_layout() {
+    const size_t n = 130;
+    population_t population = random_population(7, n, 1);
+    individual::basic_population<uint16_t> store(population, 4);
+    assert(store.size() == 7 && store.genes() == n && store.stride() == 3);
+    assert(store.objectives().rows() == 7 && store.objectives().cols() == 4);
+
+    individual::population_view view = store.view();
+    assert(view.size() == 7 && view.words().size() == 7 * 3);
+    size_t i = 0;
+    for (individual::genome_view x : view) {
+        assert(x.size() == n);
+        assert(x.data() == view.words().data() + i * 3);
+        for (size_t g = 0; g < n; g++)
+            assert(x[g] == population[i][g]);
+        i++;
+    }
+    assert(i == 7);
+    assert(store.to_population() == population);
+
+    // A view of some rows
+    individual::population_view rows = view.subview(2, 3);
+    assert(rows.size() == 3);
+    for (size_t r = 0; r < 3; r++)
+        assert(individual::to_string(rows[r]) == individual::to_string(population[2 + r]));
+}
+
+/* Rows are mutated in place and copied with their values, rank and distance. */
+void test_rows() {
+    const size_t n = 70;
+    individual::basic_population<double> store(4, n, 2);
+    for (size_t i = 0; i < 4; i++)
+        assert(store[i].size() == n && store.row(i).count() == 0);
+
+    individual::genome_ref x = store.row(1);
+    x.set(0);
+    x.set(69);
+    x.flip(3);
+    assert(x.count() == 3 && x.test(69) && store[1][3]);
+    x.flip();
+    assert(x.count() == n - 3 && !x.test(0));
+    // The padding bits stay clear
+    assert((store.view().words()[1 * 2 + 1] >> (n % 64)) == 0);
+    // Other rows are untouched
+    assert(store.row(0).count() == 0 && store.row(2).count() == 0);
+
+    store.objectives().assign(1, {1.5, 2.5});
+    store.ranks()[1] = 3;
+    store.distances()[1] = 0.25;
+    store.assign(3, store, 1);
+    assert(store.row(3).count() == n - 3);
+    assert(store.objectives()[3][0] == 1.5 && store.objectives()[3][1] == 2.5);
+    assert(store.ranks()[3] == 3 && store.distances()[3] == 0.25);
+
+    // From another arena
+    individual::basic_population<double> other(2, n, 2);
+    other.assign(0, store, 3);
+    assert(individual::to_string(other[0]) == individual::to_string(store[1]));
+    assert(other.to_population(1)[0] == store.to_population()[1]);
+}
+
+/* End criteria iterate a view without copying it. */
+void test_criteria() {
+    const size_t n = 8, m = 4;
+    population_t population = random_population(5, n, 2);
+    // On the mLOTZ Pareto front: ones then zeros in each half
+    population[0] = individual_t{1, 1, 0, 0, 1, 0, 0, 0};
+    population[1] = individual_t{0, 0, 0, 0, 1, 1, 1, 1};
+    individual::basic_population<uint16_t> store(population, m);
+
+    end_criteria::max_iterations max(3);
+    assert(!max(store.view(), 2) && max(store.view(), 3));
+    end_criteria::cover_mlotz_pareto_front cover(m);
+    assert(cover(store.view().subview(0, 2), 1));
+    population[2] = individual_t{0, 1, 0, 0, 0, 0, 0, 0};
+    individual::basic_population<uint16_t> off(population, m);
+    assert(!cover(off.view().subview(0, 3), 1));
+}
+
+int main() {
+    test_layout();
+    test_rows();
+    test_criteria();
+    std::println("All tests passed");
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "benchmark.h"
+#include "evaluation.h"
+#include "nsga2.h"
+#include "profiling.h"
+#include "rng.h"
+#include "sorting.h"
+#include "utils.h"
+#include <cassert>
+#include <print>
+#include <type_traits>
+
+using objective::compact_val_t;
+using profiling::phase;
+
+template <typename Profiler>
+using experiment_t = nsga2::NSGA2<rng::xoshiro256ss, compact_val_t, Profiler>;
+
+// The instrumentation takes no space when profiling is off
+static_assert(std::is_empty_v<profiling::none>);
+static_assert(std::is_empty_v<profiling::timer<profiling::none>>);
+static_assert(sizeof(experiment_t<profiling::none>) < sizeof(experiment_t<profiling::recorder>));
+
+// The sorter only counts its dominance comparisons when asked to
+template <typename Sorter>
+concept counts_comparisons = requires(const Sorter &s) { s.comparisons(); };
+static_assert(!counts_comparisons<sorting::sorter<uint16_t>>);
+static_assert(counts_comparisons<sorting::sorter<uint16_t, true>>);
+
+/* A counting sorter gives the same fronts, and counts as `comparisons()` says. */
+void test_sorter_counts() {
+    objective::matrix_t objectives(6, 2);
+    double values[6][2] = {{1, 5}, {2, 4}, {3, 3}, {1, 1}, {0, 2}, {3, 3}};
+    for (size_t i = 0; i < 6; i++)
+        objectives.assign(i, {values[i][0], values[i][1]});
+    for (sorting::strategy s : {sorting::strategy::deb, sorting::strategy::bi_objective,
+                                sorting::strategy::ens_ss}) {
+        sorting::sorter<double> plain;
+        sorting::sorter<double, true> counting;
+        plain.sort(objectives, s);
+        counting.sort(objectives, s);
+        assert(counting.fronts() == plain.fronts());
+        if (s == sorting::strategy::deb)
+            assert(counting.comparisons() == 6 * 6);
+        else if (s == sorting::strategy::bi_objective)
+            assert(counting.comparisons() > 0);
+        else
+            assert(!counting.comparisons().has_value());
+    }
+}
+
+/* Profiling counts every phase and does not change the run. */
+void test_counts(sorting::strategy strategy, bool delta) {
+    const size_t n = 32, m = 4, N = 20, iterations = 15;
+    auto f = delta ? objective::make_batch_objective<uint16_t>(benchmark::mlotz_functor(m))
+                   : std::make_shared<const objective::function_objective<uint16_t, compact_val_t>>(
+                         benchmark::basic_mlotz_functor<compact_val_t>(m), m);
+    end_criteria::criterion_t criterion = end_criteria::max_iterations(iterations);
+
+    experiment_t<profiling::none> plain(n, m, N, f, 11);
+    plain.set_sort_strategy(strategy);
+    nsga2::population_t expected = plain.run(criterion);
+
+    experiment_t<profiling::recorder> profiled(n, m, N, f, 11);
+    profiled.set_sort_strategy(strategy);
+    assert(profiled.run(criterion) == expected);
+
+    const profiling::recorder &profile = profiled.profile();
+    assert(profile.calls(phase::mutate) == iterations);
+    assert(profile.calls(phase::non_dominated_sort) == iterations);
+    assert(profile.calls(phase::select) == iterations);
+    // One batch for the initial population, then one per generation or one per child
+    size_t evaluations = 1 + iterations * (delta ? N : 1);
+    assert(profile.calls(phase::evaluate) == evaluations);
+    assert(profile.calls(phase::crowding_distance) <= iterations);
+    assert(profile.fronts() >= 1 && profile.last_front() <= 2 * N);
+
+    nlohmann::json json = profile.to_json();
+    assert(json["phases"]["mutate"]["calls"] == iterations);
+    assert(json["phases"]["crowding_distance_select"]["calls"] == iterations);
+    if (strategy == sorting::strategy::deb) {
+        // Each of the 2N rows is compared to each row
+        assert(profile.comparisons() == iterations * (2 * N) * (2 * N));
+        assert(json["dominance_comparisons"] == iterations * (2 * N) * (2 * N));
+    } else {
+        assert(!profile.comparisons().has_value());
+        assert(json["dominance_comparisons"].is_null());
+    }
+    std::println("{0}, delta = {1}: {2}", sorting::to_string(strategy), delta, json.dump());
+}
+
+int main() {
+    test_sorter_counts();
+    test_counts(sorting::strategy::deb, true);
+    test_counts(sorting::strategy::deb, false);
+    test_counts(sorting::strategy::ens_ss, true);
+    std::println("All tests passed");
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include "rng.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <vector>
+
+static_assert(std::uniform_random_bit_generator<rng::splitmix64>);
+static_assert(std::uniform_random_bit_generator<rng::xoshiro256ss>);
+static_assert(std::uniform_random_bit_generator<rng::pcg64>);
+static_assert(std::uniform_random_bit_generator<rng::philox4x32>);
+
+using block_t = std::array<uint32_t, 4>;
+
+/* The next 64-bit word of any generator. */
+template <typename Gen>
+uint64_t next_word(Gen &gen) {
+    uint64_t word;
+    rng::fill(gen, std::span(&word, 1));
+    return word;
+}
+
+void test_reference_outputs() {
+    // First outputs of the reference implementations
+    rng::xoshiro256ss x(std::array<uint64_t, 4>{1, 2, 3, 4});
+    assert(x() == 11520);
+    assert(x() == 0);
+    assert(x() == 1509978240);
+    assert(x() == 1215971899390074240);
+
+    rng::pcg64 p(42, 54);
+    assert(p() == 0x86b1da1d72062b68);
+    assert(p() == 0x1304aa46c9853d39);
+
+    // Known-answer vectors of Random123
+    assert(rng::philox4x32::generate({0, 0, 0, 0}, {0, 0}) ==
+           (block_t{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    assert(rng::philox4x32::generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                                     {0xa4093822, 0x299f31d0}) ==
+           (block_t{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+/* The n-th block of a Philox stream is the block of its counter. */
+void test_philox_counter() {
+    rng::philox4x32 g(0x299f31d0a4093822, 3, 5);
+    for (uint32_t n = 0; n < 10; n++) {
+        uint64_t lo = g(), hi = g();
+        block_t b = rng::philox4x32::generate({n, 0, 5, 3}, {0xa4093822, 0x299f31d0});
+        assert(lo == ((uint64_t(b[1]) << 32) | b[0]));
+        assert(hi == ((uint64_t(b[3]) << 32) | b[2]));
+    }
+}
+
+/* Streams are reproducible and differ by seed, generation and index. */
+template <typename Gen>
+void test_streams() {
+    std::vector<uint64_t> firsts;
+    for (uint64_t seed : {1, 2})
+        for (uint64_t generation : {0, 1, 2})
+            for (uint64_t index : {0, 1, 2}) {
+                Gen a = rng::stream<Gen>(seed, generation, index);
+                Gen b = rng::stream<Gen>(seed, generation, index);
+                uint64_t first = next_word(a);
+                assert(first == next_word(b));
+                firsts.push_back(first);
+            }
+    std::ranges::sort(firsts);
+    assert(std::ranges::adjacent_find(firsts) == firsts.end());
+}
+
+/* The bulk fill continues the same stream as repeated calls. */
+template <typename Gen>
+void test_fill(Gen a, Gen b) {
+    std::vector<uint64_t> words(37);
+    rng::fill(a, std::span(words).first(20));
+    rng::fill(a, std::span(words).subspan(20));
+    size_t ones = 0;
+    for (uint64_t word : words) {
+        if constexpr (Gen::max() == UINT32_MAX) {
+            uint64_t high = b();
+            assert(word == ((high << 32) | b()));
+        } else {
+            assert(word == b());
+        }
+        ones += std::popcount(word);
+    }
+    // About half of the bits are set
+    assert(ones > 37 * 64 * 4 / 10 && ones < 37 * 64 * 6 / 10);
+}
+
+int main() {
+    test_reference_outputs();
+    test_fill(rng::xoshiro256ss(7), rng::xoshiro256ss(7));
+    test_fill(rng::pcg64(7), rng::pcg64(7));
+    test_fill(std::mt19937(7), std::mt19937(7));
+    test_fill(rng::philox4x32(7), rng::philox4x32(7));
+    test_philox_counter();
+    test_streams<rng::xoshiro256ss>();
+    test_streams<rng::pcg64>();
+    test_streams<rng::philox4x32>();
+    test_streams<std::mt19937>();
+    assert(rng::xoshiro256ss(1)() != rng::xoshiro256ss(2)());
+    assert(rng::pcg64(1, 1)() != rng::pcg64(1, 2)());
+    std::println("Success");
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include "individual.h"
+#include "sorting.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cassert>
+#include <print>
+#include <random>
+
+using objective::matrix_t;
+using sorting::fronts_t;
+
+/* Sorts the indices inside each front so that fronts can be compared. */
+fronts_t normalized(fronts_t fronts) {
+    for (auto &front : fronts)
+        std::sort(front.begin(), front.end());
+    return fronts;
+}
+
+/* Random objective values in [0, levels), with many duplicates for small levels. */
+matrix_t random_objectives(size_t n, size_t m, int levels, std::mt19937 &gen) {
+    std::uniform_int_distribution<int> dist(0, levels - 1);
+    matrix_t objectives(n, m);
+    for (size_t i = 0; i < n; i++)
+        for (size_t k = 0; k < m; k++)
+            objectives.row(i)[k] = dist(gen);
+    return objectives;
+}
+
+void test_small() {
+    // 0 = (2, 2) dominates 1 = (1, 2) and 3 = (1, 1); 2 = (0, 3) is incomparable to 0
+    matrix_t objectives(5, 2);
+    objectives.assign(0, {2, 2});
+    objectives.assign(1, {1, 2});
+    objectives.assign(2, {0, 3});
+    objectives.assign(3, {1, 1});
+    objectives.assign(4, {2, 2});
+
+    fronts_t expected{{0, 2, 4}, {1}, {3}};
+    assert(normalized(sorting::graph_sort(objectives)) == expected);
+    assert(normalized(sorting::deb_sort(objectives)) == expected);
+    assert(normalized(sorting::ens_sort(objectives, false)) == expected);
+    assert(normalized(sorting::ens_sort(objectives, true)) == expected);
+    assert(normalized(sorting::bi_objective_sort(objectives)) == expected);
+    assert(normalized(sorting::divide_conquer_sort(objectives)) == expected);
+}
+
+void test_strategies_agree() {
+    std::mt19937 gen(42);
+    parallel::ThreadPool pool(3);
+    for (size_t m : {1, 2, 3, 4, 5, 8}) {
+        for (int levels : {2, 5, 100}) {
+            for (size_t n : {0, 1, 2, 3, 17, 64, 65, 200, 500}) {
+                matrix_t objectives = random_objectives(n, m, levels, gen);
+                fronts_t expected = normalized(sorting::graph_sort(objectives));
+                fronts_t deb = sorting::deb_sort(objectives);
+                assert(normalized(deb) == expected);
+                // Same fronts in the same order on several threads
+                assert(sorting::deb_sort(objectives, pool) == deb);
+                assert(normalized(sorting::ens_sort(objectives, false)) == expected);
+                assert(normalized(sorting::ens_sort(objectives, true)) == expected);
+                assert(normalized(sorting::divide_conquer_sort(objectives)) == expected);
+                if (m == 2)
+                    assert(normalized(sorting::bi_objective_sort(objectives)) == expected);
+            }
+        }
+        std::println("m = {0}: strategies agree", m);
+    }
+}
+
+/* The same values stored as integers of type `T`. */
+template <typename T>
+objective::basic_matrix<T> converted(const matrix_t &objectives) {
+    objective::basic_matrix<T> out(objectives.rows(), objectives.cols());
+    for (size_t i = 0; i < objectives.rows(); i++)
+        for (size_t k = 0; k < objectives.cols(); k++)
+            out.row(i)[k] = T(objectives[i][k]);
+    return out;
+}
+
+/* Integer values give the same fronts as their doubles, in the same order. */
+template <typename T>
+void test_integer_values() {
+    using sorting::strategy;
+    std::mt19937 gen(7);
+    for (size_t m : {2, 3, 5}) {
+        for (size_t n : {0, 1, 65, 300}) {
+            matrix_t objectives = random_objectives(n, m, 6, gen);
+            auto values = converted<T>(objectives);
+            for (strategy s : {strategy::automatic, strategy::graph, strategy::deb,
+                               strategy::ens_ss, strategy::ens_bs, strategy::divide_conquer})
+                assert(sorting::sort(values, s) == sorting::sort(objectives, s));
+            if (m == 2)
+                assert(sorting::bi_objective_sort(values) ==
+                       sorting::bi_objective_sort(objectives));
+        }
+    }
+}
+
+/* A reused sorter gives the fronts of `sort`, in the same order, and their ranks. */
+void test_sorter() {
+    using sorting::strategy;
+    std::mt19937 gen(13);
+    parallel::ThreadPool pool(3);
+    sorting::sorter<double> sorter;
+    for (size_t m : {2, 3, 5}) {
+        for (size_t n : {0, 1, 65, 300, 17}) {
+            matrix_t objectives = random_objectives(n, m, 6, gen);
+            for (strategy s : {strategy::automatic, strategy::graph, strategy::deb,
+                               strategy::ens_ss, strategy::ens_bs, strategy::divide_conquer,
+                               strategy::bi_objective}) {
+                if (s == strategy::bi_objective && m != 2)
+                    continue;
+                for (parallel::ThreadPool *threads : {(parallel::ThreadPool *)nullptr, &pool}) {
+                    fronts_t expected = sorting::sort(objectives, s, threads);
+                    sorter.sort(objectives, s, threads);
+                    assert(sorter.fronts() == expected);
+                    for (size_t k = 0; k < sorter.size(); k++)
+                        for (sorting::index_t i : sorter[k])
+                            assert(sorter.rank(i) == k);
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    test_small();
+    test_strategies_agree();
+    test_integer_values<int32_t>();
+    test_integer_values<uint16_t>();
+    test_sorter();
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "benchmark.h"
+#include "nsga2.h"
+#include "static_nsga2.h"
+#include <cassert>
+#include <print>
+
+using nsga2::population_t;
+
+/* The static path gives the same populations as the runtime-sized one. */
+template <size_t N, size_t M>
+void test_same_as_runtime(nsga2::selection_t selection, size_t threads) {
+    size_t population_size = 20;
+    end_criteria::criterion_t criterion = end_criteria::max_iterations(30);
+
+    auto runtime = nsga2::NSGA2<rng::xoshiro256ss, objective::compact_val_t>(
+        N, M, population_size, benchmark::basic_mlotz_functor<objective::compact_val_t>(M), 3);
+    runtime.set_selection(selection);
+    population_t expected = runtime.run(criterion);
+
+    auto fixed = nsga2::StaticNSGA2<N, M, benchmark::static_mlotz<N, M>>(
+        population_size, benchmark::static_mlotz<N, M>(), 3);
+    fixed.set_selection(selection);
+    fixed.set_threads(threads);
+    population_t pop = fixed.run(criterion);
+
+    assert(pop.size() == population_size);
+    assert(pop == expected);
+}
+
+/* The static mLOTZ agrees with the runtime mLOTZ. */
+template <size_t N, size_t M>
+void test_static_mlotz() {
+    rng::xoshiro256ss gen(11);
+    for (int trial = 0; trial < 200; trial++) {
+        individual::static_genome<N> x;
+        rng::fill(gen, x.words());
+        x.trim();
+        // Long runs of ones and zeros too
+        if (trial % 3 == 0)
+            for (size_t i = 0; i < N / 2; i++)
+                x.set(i, trial % 2);
+        auto fast = benchmark::static_mlotz<N, M>()(x);
+        auto slow = benchmark::mlotz(M, x.to_genome());
+        for (size_t k = 0; k < M; k++)
+            assert(fast[k] == slow[k]);
+        assert(x.count() == x.to_genome().count());
+    }
+}
+
+int main() {
+    test_static_mlotz<12, 4>();
+    test_static_mlotz<70, 2>();
+    test_static_mlotz<130, 10>();
+    test_same_as_runtime<12, 4>(nsga2::selection_t::crowding_distance, 1);
+    test_same_as_runtime<16, 2>(nsga2::selection_t::dynamic, 3);
+    test_same_as_runtime<70, 2>(nsga2::selection_t::crowding_distance, 2);
+    std::println("Success");
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "thread_pool.h"
+#include <atomic>
+#include <cassert>
+#include <print>
+#include <vector>
+
+/* Every index is visited exactly once, in chunks of consecutive indices. */
+void test_coverage(parallel::ThreadPool &pool) {
+    for (size_t n : {0, 1, 2, 7, 64, 1000, 4097}) {
+        std::vector<std::atomic<int>> visits(n);
+        std::atomic<size_t> chunks = 0;
+        pool.parallel_for(n, [&](size_t begin, size_t end) {
+            assert(begin < end && end <= n);
+            for (size_t i = begin; i < end; i++)
+                visits[i]++;
+            chunks++;
+        });
+        for (size_t i = 0; i < n; i++)
+            assert(visits[i] == 1);
+        assert(chunks <= n);
+    }
+}
+
+/* The pool is reused by many consecutive loops. */
+void test_reuse(parallel::ThreadPool &pool) {
+    std::vector<size_t> sums(1000, 0);
+    for (size_t loop = 0; loop < 200; loop++) {
+        pool.parallel_for(sums.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+                sums[i] += i;
+        });
+    }
+    for (size_t i = 0; i < sums.size(); i++)
+        assert(sums[i] == 200 * i);
+}
+
+/* Each thread of a loop has its own index, below the size of the pool. */
+void test_index(parallel::ThreadPool &pool) {
+    assert(parallel::ThreadPool::index() == 0);
+    std::vector<std::atomic<int>> seen(pool.size());
+    pool.parallel_for(10000, [&](size_t, size_t) {
+        size_t index = parallel::ThreadPool::index();
+        assert(index < pool.size());
+        seen[index]++;
+    });
+}
+
+int main() {
+    for (size_t threads : {0, 1, 2, 3, 8}) {
+        parallel::ThreadPool pool(threads);
+        assert(pool.size() == std::max<size_t>(threads, 1));
+        test_coverage(pool);
+        test_reuse(pool);
+        test_index(pool);
+    }
+    std::println("Success");
+    return 0;
+}
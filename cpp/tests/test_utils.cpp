@@ -0,0 +1,76 @@
+#include "individual.h"
+#include "population.h"
+#include "utils.h"
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <print>
+#include <string>
+#include <vector>
+
+using individual::individual_t;
+using nlohmann::json;
+
+/* The records of the log `filename`, one per line. */
+std::vector<json> read_log(const std::string &filename) {
+    std::ifstream file(filename);
+    std::vector<json> records;
+    for (std::string line; std::getline(file, line);)
+        records.push_back(json::parse(line));
+    return records;
+}
+
+/* The log is appended to in batches of whole records. */
+void test_streaming_log() {
+    const std::string filename = "test_utils_log.json";
+    const size_t n = 8, m = 4, N = 3, max_iters = 10;
+    // Two individuals out of three on the mLOTZ Pareto front
+    individual::population_t population{individual_t{1, 1, 0, 0, 1, 0, 0, 0},
+                                        individual_t{0, 0, 0, 0, 1, 1, 1, 1},
+                                        individual_t{0, 1, 0, 0, 0, 0, 0, 0}};
+    individual::basic_population<uint16_t> store(population, m);
+    {
+        end_criteria::Task6Logger logger(n, N, m, max_iters, filename, 5, 4);
+        std::vector<json> records = read_log(filename);
+        assert(records.size() == 1);
+        assert(records[0]["type"] == "metadata");
+        assert(records[0]["population_size"] == N && records[0]["objective_size"] == m);
+        assert(records[0].contains("begin_time"));
+
+        for (size_t iter = 0; iter < 6; iter++)
+            assert(!logger(store.view(), iter));
+        // One batch of four generations, two still buffered
+        records = read_log(filename);
+        assert(records.size() == 5);
+        for (size_t i = 1; i < 5; i++) {
+            assert(records[i]["type"] == "generation");
+            assert(records[i]["iteration"] == i - 1);
+            assert(records[i]["count_pareto_front"] == 2);
+        }
+
+        assert(logger(store.view(), max_iters));
+        records = read_log(filename);
+        assert(records.size() == 9);
+        assert(records[8]["type"] == "final_population");
+        assert(records[8]["final_population"].size() == N);
+        assert(records[8]["final_population"][0] == "11001000");
+        assert(records[8].contains("end_time"));
+    }
+
+    // The buffered records of an interrupted run are appended on destruction
+    {
+        end_criteria::Task6Logger logger(n, N, m, max_iters, filename, 5, 100);
+        for (size_t iter = 0; iter < 3; iter++)
+            logger(store.view(), iter);
+        assert(read_log(filename).size() == 1);
+    }
+    assert(read_log(filename).size() == 4);
+    std::remove(filename.c_str());
+}
+
+int main() {
+    test_streaming_log();
+    std::println("All tests passed");
+    return 0;
+}
@@ -17,7 +17,12 @@ fig, ax = plt.subplots(1, 1, figsize=(10, 10))
 
 # TODO prettier plots with metadata and labels using seaborn
 
-# The data is in the following format:
+# Each log is newline-delimited JSON, one record per line:
+#    {"type": "metadata", "begin_time": ..., "individual_size": 10, ...}
+#    {"type": "generation", "iteration": 0, "count_pareto_front": 1}
+#    ...
+#    {"type": "final_population", "end_time": ..., "final_population": [...]}
+# `load_log` gathers them into the format of the older single-document logs:
 #    "count_pareto_front": [
 #         1, 3, 6, 7, 12, 21, 37, 62, 88, 100
 #     ],
@@ -40,6 +45,46 @@ fig, ax = plt.subplots(1, 1, figsize=(10, 10))
 #     }
 
 
+def parse_record(line):
+    """The record of a line of a log, or None if the line is not JSON."""
+    try:
+        return json.loads(line)
+    except json.JSONDecodeError:
+        return None
+
+
+def load_log(file):
+    """Reads a log, either newline-delimited or a single JSON document.
+
+    A log is newline-delimited when its first line is a record with a "type".
+    A run which crashed may end with a truncated line, which is skipped, and
+    has no end time. It may also hold only its metadata line.
+    """
+    with open(file, 'r') as f:
+        text = f.read()
+    lines = text.splitlines()
+    first = parse_record(lines[0]) if lines else None
+    if not (isinstance(first, dict) and 'type' in first):
+        data = json.loads(text)
+        if not (isinstance(data, dict) and 'metadata' in data):
+            raise ValueError(f"{file}: not a NSGA-II log")
+        return data
+    data = {'metadata': {}, 'count_pareto_front': [], 'final_population': []}
+    for line in lines:
+        record = parse_record(line)
+        if not isinstance(record, dict):
+            continue
+        kind = record.pop('type', None)
+        if kind == 'metadata':
+            data['metadata'].update(record)
+        elif kind == 'generation':
+            data['count_pareto_front'].append(record['count_pareto_front'])
+        elif kind == 'final_population':
+            data['metadata']['end_time'] = record['end_time']
+            data['final_population'] = record['final_population']
+    return data
+
+
 def plot_pareto_front_proportion(data_path):
     data_path = Path(data_path)
     if not any(data_path.iterdir()):
@@ -55,28 +100,33 @@ def plot_pareto_front_proportion(data_path):
     total_steps = []
     success = []
     for file in data_path.glob('*.json'):
-        with open(file, 'r') as f:
-            data = json.load(f)
-            print(data["metadata"])
-
-            fmt = "%Y-%m-%d %H:%M:%S"
-            start_time = datetime.strptime(data['metadata']['start_time'], fmt)
+        # Written by --profile next to the logs
+        if file.name.endswith('.profile.json'):
+            continue
+        data = load_log(file)
+        print(data["metadata"])
+
+        fmt = "%Y-%m-%d %H:%M:%S"
+        if 'end_time' in data['metadata']:
+            begin_time = datetime.strptime(data['metadata']['begin_time'], fmt)
             end_time = datetime.strptime(data['metadata']['end_time'], fmt)
-            running_time.append((end_time - start_time).total_seconds())
-
-            pareto_coverage = np.array(data['count_pareto_front'])
-            population_size = data['metadata']['population_size']
-            num_steps = len(pareto_coverage)
-
-            # Plot the results
-            x = np.arange(num_steps)
-            y = pareto_coverage / population_size
-            sns.lineplot(x=x, y=y, label=file.stem, ax=ax)
-            xs.append(x)
-            ys.append(y)
-
-            total_steps.append(num_steps)
-            success.append(pareto_coverage[-1] == population_size)
+            running_time.append((end_time - begin_time).total_seconds())
+
+        pareto_coverage = np.array(data['count_pareto_front'])
+        population_size = data['metadata']['population_size']
+        num_steps = len(pareto_coverage)
+        if num_steps == 0:
+            continue
+
+        # Plot the results
+        x = np.arange(num_steps)
+        y = pareto_coverage / population_size
+        sns.lineplot(x=x, y=y, label=file.stem, ax=ax)
+        xs.append(x)
+        ys.append(y)
+
+        total_steps.append(num_steps)
+        success.append(pareto_coverage[-1] == population_size)
 
     ax.set_xlabel('Iterations')
     ax.set_ylabel('Proportion of Population')
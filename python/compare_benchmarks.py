@@ -0,0 +1,52 @@
+# Compares two result files of `bench_suite --json`, e.g. of two releases.
+#
+#   python compare_benchmarks.py baseline.json current.json --threshold 1.1
+#
+# Prints the ratio current / baseline of the time of each benchmark found in
+# both files, and exits with status 1 if one of them is slower than the
+# threshold.
+
+import argparse
+import json
+import sys
+
+
+def key(result):
+    return (result['group'], result['name'], json.dumps(result['params'], sort_keys=True))
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return data['metadata'], {key(r): r for r in data['results']}
+
+
+parser = argparse.ArgumentParser(description='Compare two benchmark result files.')
+parser.add_argument('baseline', help='results of the reference run')
+parser.add_argument('current', help='results of the run to check')
+parser.add_argument('--threshold', type=float, default=1.1,
+                    help='slowdown ratio above which a benchmark is reported as a regression')
+args = parser.parse_args()
+
+baseline_metadata, baseline = load(args.baseline)
+current_metadata, current = load(args.current)
+for field in sorted(set(baseline_metadata) | set(current_metadata)):
+    before, after = baseline_metadata.get(field), current_metadata.get(field)
+    if before != after:
+        print(f'{field}: {before} -> {after}')
+
+regressions = 0
+for k in sorted(set(baseline) & set(current)):
+    group, name, params = k
+    ratio = current[k]['ns_per_op'] / baseline[k]['ns_per_op']
+    flag = ''
+    if ratio > args.threshold:
+        flag = '  REGRESSION'
+        regressions += 1
+    print(f'{group:<12} {name:<24} {params:<48} {ratio:6.2f}x{flag}')
+
+for k in sorted(set(baseline) ^ set(current)):
+    print(f'only in {"baseline" if k in baseline else "current"}: {" ".join(k)}')
+
+print(f'{regressions} regression(s) above {args.threshold}x')
+sys.exit(1 if regressions else 0)
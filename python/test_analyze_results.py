@@ -0,0 +1,64 @@
+# Tests of `load_log`, run with
+#
+#   python -m unittest test_analyze_results.py
+
+import json
+import tempfile
+import unittest
+from pathlib import Path
+
+import matplotlib
+matplotlib.use('Agg')
+
+from analyze_results import load_log
+
+METADATA = {"type": "metadata", "begin_time": "2024-01-01 00:00:00",
+            "individual_size": 10, "max_iters": 1000, "objective_size": 2,
+            "population_size": 100}
+
+
+class LoadLogTest(unittest.TestCase):
+    def load(self, text):
+        with tempfile.TemporaryDirectory() as directory:
+            path = Path(directory) / 'log.json'
+            path.write_text(text)
+            return load_log(path)
+
+    def test_newline_delimited(self):
+        records = [METADATA,
+                   {"type": "generation", "iteration": 0, "count_pareto_front": 1},
+                   {"type": "generation", "iteration": 1, "count_pareto_front": 3},
+                   {"type": "final_population", "end_time": "2024-01-01 00:00:01",
+                    "final_population": ["1111111000"]}]
+        data = self.load(''.join(json.dumps(r) + '\n' for r in records))
+        self.assertEqual(data['count_pareto_front'], [1, 3])
+        self.assertEqual(data['final_population'], ["1111111000"])
+        self.assertEqual(data['metadata']['population_size'], 100)
+        self.assertEqual(data['metadata']['end_time'], "2024-01-01 00:00:01")
+
+    def test_truncated(self):
+        text = json.dumps(METADATA) + '\n' + '{"type": "generation", "itera'
+        data = self.load(text)
+        self.assertEqual(data['count_pareto_front'], [])
+        self.assertNotIn('end_time', data['metadata'])
+
+    def test_metadata_only(self):
+        # A run which crashed before its first flush
+        data = self.load(json.dumps(METADATA) + '\n')
+        self.assertEqual(data['metadata']['population_size'], 100)
+        self.assertEqual(data['count_pareto_front'], [])
+        self.assertEqual(data['final_population'], [])
+
+    def test_single_document(self):
+        old = {"count_pareto_front": [1, 3], "final_population": ["1111111000"],
+               "metadata": {"begin_time": "2024-01-01 00:00:00", "population_size": 100}}
+        self.assertEqual(self.load(json.dumps(old, indent=4)), old)
+        self.assertEqual(self.load(json.dumps(old)), old)
+
+    def test_not_a_log(self):
+        with self.assertRaises(ValueError):
+            self.load(json.dumps({"results": []}))
+
+
+if __name__ == '__main__':
+    unittest.main()